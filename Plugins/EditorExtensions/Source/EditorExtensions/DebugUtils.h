@@ -25,7 +25,7 @@ namespace DebugHelper
 		const FString TitleMsg = bShowMsgAsWarning?"Warning":"Interaction";
 		const FText TitleText = FText::FromString(TitleMsg);
 
-		return FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Message), &TitleText);
+		return FMessageDialog::Open(MsgType, FText::FromString(Message), &TitleText);
 
 	}
 
@@ -43,10 +43,16 @@ public class EditorExtensions : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
+				"AssetRegistry",
+				"DeveloperToolSettings",
 				"Engine",
 				"Slate",
 				"SlateCore",
 				"EditorScriptingUtilities",
+				"EngineSettings",
+				"ImageCore",
+				"MeshDescription",
+				"StaticMeshDescription",
 				"UnrealEd"
 			}
 		);
@@ -1,9 +1,13 @@
 #include "AssetActions/AssetActionExtender.h"
+#include "EditorExtensions.h"
 #include "AssetToolsModule.h"
 #include "EditorUtilityLibrary.h"
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
 #include "AssetActions/AssetActionExtenderSettings.h"
+#include "AssetActions/RedirectorFixupService.h"
+#include "AssetDeletion/AssetBatchDeletion.h"
+#include "AssetDeletion/UnusedAssetTracker.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "EditorExtensions/DebugUtils.h"
 
@@ -89,23 +93,24 @@ void UAssetActionExtender::CleanupName(bool bReplaceBADPrefixes)
 void UAssetActionExtender::RemoveUnusedAssets()
 {
     TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+    const FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
+
     TArray<FAssetData> UnusedAssetsData;
-    for (FAssetData& SelectedAssetData : SelectedAssetsData)
+    EditorExtensionsModule.GetUnusedAssetTracker().FilterUnusedAssets(SelectedAssetsData, UnusedAssetsData);
+
+    TArray<FString> SelectedFolderPaths;
+    for (const FAssetData& SelectedAssetData : SelectedAssetsData)
     {
-       TArray<FString> AssetReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(SelectedAssetData.ObjectPath.ToString());
-       if (AssetReferences.IsEmpty())
-       {
-          UnusedAssetsData.Add(SelectedAssetData);
-       }
+       SelectedFolderPaths.AddUnique(SelectedAssetData.PackagePath.ToString());
     }
-    FixUpRedirectors();
+    FixUpRedirectors(SelectedFolderPaths);
     if (UnusedAssetsData.IsEmpty())
     {
        DebugHelper::ShowNotifyInfo("Unused assets not found");
        return;
     }
 
-    const int32 NumOfDeletedAssets = ObjectTools::DeleteAssets(UnusedAssetsData);
+    const int32 NumOfDeletedAssets = FAssetBatchDeletion::DeleteAssets(UnusedAssetsData);
 
     if (NumOfDeletedAssets != 0)
     {
@@ -179,25 +184,10 @@ bool UAssetActionExtender::IsPrefixExist(const FString& ObjName, FString& Prefix
 
 void UAssetActionExtender::FixUpRedirectors()
 {
-    TArray<UObjectRedirector*> RedirectorsFixArray;
-    const FAssetRegistryModule& AssetRegistryModule = FModuleManager::Get().LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-
-    FARFilter Filter;
-    Filter.bRecursivePaths = true;
-    Filter.PackagePaths.Emplace("/Game");
-    Filter.ClassPaths.Emplace("ObjectRedirector");
-
-    TArray<FAssetData> OutRedirectors;
-    AssetRegistryModule.Get().GetAssets(Filter, OutRedirectors);
-
-    for(const FAssetData& RedirectorData : OutRedirectors)
-    {
-       if(UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
-       {
-          RedirectorsFixArray.Add(RedirectorToFix);
-       }
-    }
-
-    const FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
-    AssetToolsModule.Get().FixupReferencers(RedirectorsFixArray);
+    FixUpRedirectors({ TEXT("/Game") });
+}
+void UAssetActionExtender::FixUpRedirectors(const TArray<FString>& ScopeFolderPaths)
+{
+    const FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
+    EditorExtensionsModule.GetRedirectorFixupService().RequestFixup(ScopeFolderPaths);
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetFolderEnumerator.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FAssetFolderEnumerator::GetAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutAssets, const bool bRecursive)
+{
+	GetAssetsUnderFolders({ FolderPath }, OutAssets, bRecursive);
+}
+void FAssetFolderEnumerator::GetAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssets, const bool bRecursive)
+{
+	FARFilter Filter;
+	Filter.bRecursivePaths = bRecursive;
+	for (const FString& FolderPath : FolderPaths)
+	{
+		FString PackagePath = FolderPath;
+		PackagePath.RemoveFromEnd(TEXT("/"));
+		Filter.PackagePaths.Emplace(PackagePath);
+	}
+
+	if (!Filter.PackagePaths.IsEmpty())
+	{
+		RunQuery(Filter, OutAssets);
+	}
+}
+void FAssetFolderEnumerator::GetAssetsInPackages(const TArray<FName>& PackageNames, TArray<FAssetData>& OutAssets)
+{
+	FARFilter Filter;
+	Filter.PackageNames = PackageNames;
+
+	if (!Filter.PackageNames.IsEmpty())
+	{
+		RunQuery(Filter, OutAssets);
+	}
+}
+void FAssetFolderEnumerator::RunQuery(FARFilter& Filter, TArray<FAssetData>& OutAssets)
+{
+	Filter.bIncludeOnlyOnDiskAssets = !IsInGameThread();
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	const int32 FirstNewAsset = OutAssets.Num();
+	AssetRegistryModule.Get().GetAssets(Filter, OutAssets);
+
+	for (int32 AssetIndex = OutAssets.Num() - 1; AssetIndex >= FirstNewAsset; --AssetIndex)
+	{
+		if (OutAssets[ AssetIndex ].IsRedirector())
+		{
+			OutAssets.RemoveAtSwap(AssetIndex, 1, false);
+		}
+	}
+}
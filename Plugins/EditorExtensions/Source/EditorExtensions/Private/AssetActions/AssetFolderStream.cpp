@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetFolderStream.h"
+
+#include "AssetActions/AssetFolderEnumerator.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+
+TSharedRef<FAssetFolderStream> FAssetFolderStream::Launch(const TArray<FString>& RootPaths, const FAssetExclusionMatcher& Matcher)
+{
+	TSharedRef<FAssetFolderStream> Stream = MakeShared<FAssetFolderStream>();
+	Stream->RootPaths = RootPaths;
+
+	Async(EAsyncExecution::ThreadPool, [Stream, RootPaths, Matcher]()
+	{
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+		TArray<FString> FolderPaths;
+		for (FString RootPath : RootPaths)
+		{
+			RootPath.RemoveFromEnd(TEXT("/"));
+			AssetRegistry.GetSubPaths(RootPath, FolderPaths, true);
+			FolderPaths.Add(MoveTemp(RootPath));
+		}
+		Stream->Progress.SetTotal(FolderPaths.Num());
+
+		TArray<FAssetData> FolderAssets;
+		for (const FString& FolderPath : FolderPaths)
+		{
+			if (Stream->Progress.IsCancelRequested())
+			{
+				break;
+			}
+
+			FolderAssets.Reset();
+			FAssetFolderEnumerator::GetAssetsUnderFolder(FolderPath, FolderAssets, false);
+			Stream->NumExcludedAssets.fetch_add(Matcher.RemoveExcludedAssets(FolderAssets), std::memory_order_relaxed);
+
+			if (!FolderAssets.IsEmpty())
+			{
+				TArray<TSharedPtr<FAssetData>> FolderBatch;
+				FolderBatch.Reserve(FolderAssets.Num());
+				for (FAssetData& AssetData : FolderAssets)
+				{
+					FolderBatch.Add(MakeShared<FAssetData>(MoveTemp(AssetData)));
+				}
+				Stream->FolderBatches.Enqueue(MoveTemp(FolderBatch));
+			}
+			Stream->Progress.Advance();
+		}
+
+		Stream->bEnumerated.store(true, std::memory_order_release);
+	});
+
+	return Stream;
+}
+void FAssetFolderStream::Dequeue(TArray<TSharedPtr<FAssetData>>& OutAssets, const int32 MaxAssets)
+{
+	int32 NumTaken = 0;
+	TArray<TSharedPtr<FAssetData>> FolderBatch;
+	while (NumTaken < MaxAssets && FolderBatches.Dequeue(FolderBatch))
+	{
+		NumTaken += FolderBatch.Num();
+		OutAssets.Append(MoveTemp(FolderBatch));
+	}
+}
+bool FAssetFolderStream::IsFinished() const
+{
+	// The flag is raised after the last enqueue, so an empty queue seen after it stays empty
+	return bEnumerated.load(std::memory_order_acquire) && FolderBatches.IsEmpty();
+}
@@ -1,5 +1,6 @@
 #include "AssetActions/MaterialCreationWidget.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
 #include "EditorAssetLibrary.h"
 #include "EditorUtilityLibrary.h"
@@ -124,17 +125,18 @@ bool UMaterialCreationWidget::ProcessSelectedData(const TArray<FAssetData>& Sele
 // Will return true if the material name is used by asset under the specified folder
 bool UMaterialCreationWidget::IsMaterialNameUsed(const FString& MaterialFolderPath, const FString& MaterialNameToCheck)
 {
-	TArray<FString> ExistingAssetPaths = UEditorAssetLibrary::ListAssets(MaterialFolderPath, false);
+	// Asked for the package itself, so a redirector left behind by a rename or an unsaved asset still holds the name
+	const FString MaterialPackageName = MaterialFolderPath / MaterialNameToCheck;
 
-	for (const FString& AssetPath : ExistingAssetPaths)
+	TArray<FAssetData> ExistingAssets;
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	AssetRegistryModule.Get().GetAssetsByPackageName(FName(*MaterialPackageName), ExistingAssets, false, false);
+
+	if (!ExistingAssets.IsEmpty() || FindPackage(nullptr, *MaterialPackageName))
 	{
-		const FString ExistingAssetName = FPaths::GetBaseFilename(AssetPath);
-		if (ExistingAssetName == MaterialNameToCheck)
-		{
-			DebugHelper::ShowMsgDialog(EAppMsgType::Ok, MaterialNameToCheck + TEXT(" is already used by asset"));
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, MaterialNameToCheck + TEXT(" is already used by asset"));
 
-			return true;
-		}
+		return true;
 	}
 	return false;
 }
@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/RedirectorFixupService.h"
+
+#include "AssetToolsModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FRedirectorFixupService::Initialize()
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FRedirectorFixupService::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FRedirectorFixupService::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FRedirectorFixupService::OnAssetRenamed);
+}
+void FRedirectorFixupService::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	PendingRedirectorPackages.Reset();
+	bNeedsInitialScan = true;
+}
+void FRedirectorFixupService::RequestFixup(const TArray<FString>& ScopeFolderPaths)
+{
+	// Fixing up can pump the UI through its progress dialog, a nested request has nothing to add
+	if (bFixupInProgress || !HasPendingRedirectors())
+	{
+		return;
+	}
+	TGuardValue<bool> FixupGuard(bFixupInProgress, true);
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	const IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	// Everything up to the final load works from registry metadata, no redirector package is opened
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UObjectRedirector::StaticClass()->GetClassPathName());
+	if (bNeedsInitialScan)
+	{
+		Filter.bRecursivePaths = true;
+		Filter.PackagePaths.Emplace("/Game");
+	}
+	else
+	{
+		Filter.PackageNames = PendingRedirectorPackages.Array();
+	}
+
+	TArray<FAssetData> OutRedirectors;
+	AssetRegistry.GetAssets(Filter, OutRedirectors);
+
+	bNeedsInitialScan = false;
+	PendingRedirectorPackages.Reset();
+
+	if (OutRedirectors.IsEmpty())
+	{
+		return;
+	}
+
+	TSet<FString> ScopeRoots;
+	for (FString ScopeFolderPath : ScopeFolderPaths)
+	{
+		ScopeFolderPath.RemoveFromEnd(TEXT("/"));
+		ScopeRoots.Add(MoveTemp(ScopeFolderPath));
+	}
+
+	auto IsInScope = [&ScopeRoots](const FName PackageName)
+	{
+		FString FolderPath = FPackageName::GetLongPackagePath(PackageName.ToString());
+		while (!FolderPath.IsEmpty())
+		{
+			if (ScopeRoots.Contains(FolderPath))
+			{
+				return true;
+			}
+
+			int32 LastSlashIndex = INDEX_NONE;
+			if (!FolderPath.FindLastChar(TEXT('/'), LastSlashIndex))
+			{
+				break;
+			}
+			FolderPath.LeftInline(LastSlashIndex);
+		}
+		return false;
+	};
+
+	// Redirector package -> package its DestinationObject tag points at
+	TMap<FName, FName> RedirectorDestinations;
+	for (const FAssetData& RedirectorData : OutRedirectors)
+	{
+		FString DestinationObject;
+		if (RedirectorData.GetTagValue(FName("DestinationObject"), DestinationObject))
+		{
+			const FString DestinationObjectPath = FPackageName::ExportTextPathToObjectPath(DestinationObject);
+			RedirectorDestinations.Add(RedirectorData.PackageName, FName(FPackageName::ObjectPathToPackageName(DestinationObjectPath)));
+		}
+	}
+
+	TSet<FName> RedirectorPackagesToFix;
+	TArray<FName> Referencers;
+	for (const FAssetData& RedirectorData : OutRedirectors)
+	{
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(RedirectorData.PackageName, Referencers);
+		Referencers.Remove(RedirectorData.PackageName);
+
+		// Nothing points at it, there is nothing to fix up, now or later
+		if (Referencers.IsEmpty())
+		{
+			continue;
+		}
+
+		if (!IsInScope(RedirectorData.PackageName) && !Referencers.ContainsByPredicate(IsInScope))
+		{
+			PendingRedirectorPackages.Add(RedirectorData.PackageName);
+			continue;
+		}
+
+		// Fix the rest of the chain in the same pass, so referencers end up on the final target instead of the next hop
+		for (FName ChainPackage = RedirectorData.PackageName; !RedirectorPackagesToFix.Contains(ChainPackage);)
+		{
+			RedirectorPackagesToFix.Add(ChainPackage);
+
+			const FName* NextPackage = RedirectorDestinations.Find(ChainPackage);
+			if (!NextPackage || !RedirectorDestinations.Contains(*NextPackage))
+			{
+				break;
+			}
+			ChainPackage = *NextPackage;
+		}
+	}
+
+	if (RedirectorPackagesToFix.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<UObjectRedirector*> RedirectorsFixArray;
+	for (const FAssetData& RedirectorData : OutRedirectors)
+	{
+		if (!RedirectorPackagesToFix.Contains(RedirectorData.PackageName))
+		{
+			continue;
+		}
+
+		PendingRedirectorPackages.Remove(RedirectorData.PackageName);
+		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(RedirectorData.GetAsset()))
+		{
+			RedirectorsFixArray.Add(RedirectorToFix);
+		}
+	}
+
+	const FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+	AssetToolsModule.Get().FixupReferencers(RedirectorsFixArray);
+}
+void FRedirectorFixupService::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (AssetData.IsRedirector())
+	{
+		PendingRedirectorPackages.Add(AssetData.PackageName);
+	}
+}
+void FRedirectorFixupService::OnAssetRemoved(const FAssetData& AssetData)
+{
+	PendingRedirectorPackages.Remove(AssetData.PackageName);
+}
+void FRedirectorFixupService::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// A rename or move usually leaves a redirector behind at the old path, the next request checks it
+	PendingRedirectorPackages.Add(FName(FPackageName::ObjectPathToPackageName(OldObjectPath)));
+}
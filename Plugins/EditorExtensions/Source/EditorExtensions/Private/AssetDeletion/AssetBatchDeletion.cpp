@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetBatchDeletion.h"
+
+#include "ObjectTools.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorExtensions/DebugUtils.h"
+#include "Misc/ScopedSlowTask.h"
+
+namespace AssetBatchDeletion
+{
+	// Dialogs name this many assets, the rest are only counted
+	constexpr int32 MaxListedAssets = 20;
+
+	FString ListAssetNames(const TArray<FAssetData>& Assets)
+	{
+		FString AssetNames;
+		for (int32 AssetIndex = 0; AssetIndex < FMath::Min(Assets.Num(), MaxListedAssets); ++AssetIndex)
+		{
+			AssetNames += Assets[ AssetIndex ].GetObjectPathString() + TEXT("\n");
+		}
+		if (Assets.Num() > MaxListedAssets)
+		{
+			AssetNames += FString::Printf(TEXT("... and %d more"), Assets.Num() - MaxListedAssets);
+		}
+		return AssetNames;
+	}
+}
+
+int32 FAssetBatchDeletion::DeleteAssets(const TArray<FAssetData>& AssetsToDelete)
+{
+	if (AssetsToDelete.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Batches are deleted without the reference dialog of ObjectTools, so referenced assets are set aside up front
+	TArray<FAssetData> UnreferencedAssets;
+	TArray<FAssetData> ReferencedAssets;
+	SplitByExternalReferencers(AssetsToDelete, UnreferencedAssets, ReferencedAssets);
+
+	// Batches are only cut once referencers come before what they reference, so no batch is refused for a
+	// reference from an asset still waiting in a later batch
+	TArray<TArray<FAssetData>> DeletionGroups;
+	OrderForDeletion(UnreferencedAssets, DeletionGroups);
+
+	TArray<TArray<FAssetData>> Batches;
+	SplitIntoBatches(DeletionGroups, Batches);
+
+	FString ConfirmMessage = UnreferencedAssets.IsEmpty() ? FString(TEXT("Nothing can be deleted.")) : TEXT("Delete ") + FString::FromInt(UnreferencedAssets.Num()) + TEXT(" assets in ") + FString::FromInt(Batches.Num()) + TEXT(" batches?");
+	if (!ReferencedAssets.IsEmpty())
+	{
+		ConfirmMessage += TEXT("\n\n") + FString::FromInt(ReferencedAssets.Num()) + TEXT(" assets are still referenced and will be kept:\n") + AssetBatchDeletion::ListAssetNames(ReferencedAssets);
+	}
+
+	if (UnreferencedAssets.IsEmpty())
+	{
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, ConfirmMessage, true);
+		return 0;
+	}
+
+	const EAppReturnType::Type ConfirmReturn = DebugHelper::ShowMsgDialog(EAppMsgType::OkCancel, ConfirmMessage);
+	if (ConfirmReturn != EAppReturnType::Ok)
+	{
+		return 0;
+	}
+
+	FScopedSlowTask SlowTask(Batches.Num(), FText::FromString(TEXT("Deleting assets")));
+	SlowTask.MakeDialog(true);
+
+	int32 NumOfDeletedAssets = 0;
+	for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+	{
+		if (SlowTask.ShouldCancel())
+		{
+			break;
+		}
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(FString::Printf(TEXT("Deleting batch %d / %d"), BatchIndex + 1, Batches.Num())));
+
+		const int32 NumOfDeletedInBatch = ObjectTools::DeleteAssets(Batches[ BatchIndex ], false);
+		NumOfDeletedAssets += NumOfDeletedInBatch;
+
+		DebugHelper::PrintLog(FString::Printf(TEXT("Deletion batch %d / %d: deleted %d of %d assets"), BatchIndex + 1, Batches.Num(), NumOfDeletedInBatch, Batches[ BatchIndex ].Num()));
+
+		// Release what this batch loaded before the next one loads more
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// Whatever is still registered was kept, whether it was referenced, cancelled or refused by ObjectTools
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FAssetData> KeptAssets;
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		if (AssetRegistryModule.Get().GetAssetByObjectPath(AssetData.GetSoftObjectPath(), true).IsValid())
+		{
+			KeptAssets.Add(AssetData);
+		}
+	}
+
+	if (!KeptAssets.IsEmpty())
+	{
+		for (const FAssetData& KeptAsset : KeptAssets)
+		{
+			DebugHelper::PrintLog(TEXT("Not deleted: ") + KeptAsset.GetObjectPathString());
+		}
+		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, FString::FromInt(KeptAssets.Num()) + TEXT(" assets were not deleted:\n") + AssetBatchDeletion::ListAssetNames(KeptAssets), true);
+	}
+
+	return NumOfDeletedAssets;
+}
+void FAssetBatchDeletion::SplitByExternalReferencers(const TArray<FAssetData>& AssetsToDelete, TArray<FAssetData>& OutUnreferenced, TArray<FAssetData>& OutReferenced)
+{
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TMap<FName, TArray<FName>> ReferencersByPackage;
+	ReferencersByPackage.Reserve(AssetsToDelete.Num());
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		if (!ReferencersByPackage.Contains(AssetData.PackageName))
+		{
+			AssetRegistryModule.Get().GetReferencers(AssetData.PackageName, ReferencersByPackage.Add(AssetData.PackageName), UE::AssetRegistry::EDependencyCategory::Package);
+		}
+	}
+
+	// Referencers that are deleted along with a package don't keep it. Keeping a package can leave what only it
+	// references kept as well, so this runs until no more packages are kept.
+	TSet<FName> PackagesToDelete;
+	ReferencersByPackage.GetKeys(PackagesToDelete);
+
+	bool bAnyKept = true;
+	while (bAnyKept)
+	{
+		bAnyKept = false;
+		for (const TPair<FName, TArray<FName>>& Pair : ReferencersByPackage)
+		{
+			if (!PackagesToDelete.Contains(Pair.Key))
+			{
+				continue;
+			}
+
+			const bool bReferenced = Pair.Value.ContainsByPredicate([&PackagesToDelete](const FName Referencer)
+			{
+				return !PackagesToDelete.Contains(Referencer);
+			});
+			if (bReferenced)
+			{
+				PackagesToDelete.Remove(Pair.Key);
+				bAnyKept = true;
+			}
+		}
+	}
+
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		(PackagesToDelete.Contains(AssetData.PackageName) ? OutUnreferenced : OutReferenced).Add(AssetData);
+	}
+}
+void FAssetBatchDeletion::OrderForDeletion(const TArray<FAssetData>& AssetsToDelete, TArray<TArray<FAssetData>>& OutDeletionGroups)
+{
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	// One node per package, all of a package's assets go together
+	TMap<FName, int32> NodeByPackage;
+	TArray<TArray<FAssetData>> AssetsByNode;
+	for (const FAssetData& AssetData : AssetsToDelete)
+	{
+		int32& NodeIndex = NodeByPackage.FindOrAdd(AssetData.PackageName, AssetsByNode.Num());
+		if (NodeIndex == AssetsByNode.Num())
+		{
+			AssetsByNode.AddDefaulted();
+		}
+		AssetsByNode[ NodeIndex ].Add(AssetData);
+	}
+	const int32 NumNodes = AssetsByNode.Num();
+
+	// Edges lead from a package to its referencers in the list
+	TArray<TArray<int32>> ReferencerNodes;
+	ReferencerNodes.SetNum(NumNodes);
+	TArray<FName> Referencers;
+	for (const TPair<FName, int32>& Pair : NodeByPackage)
+	{
+		Referencers.Reset();
+		AssetRegistryModule.Get().GetReferencers(Pair.Key, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+		for (const FName Referencer : Referencers)
+		{
+			const int32* ReferencerNode = NodeByPackage.Find(Referencer);
+			if (ReferencerNode && *ReferencerNode != Pair.Value)
+			{
+				ReferencerNodes[ Pair.Value ].Add(*ReferencerNode);
+			}
+		}
+	}
+
+	// Tarjan's algorithm, iterative so long reference chains can't overflow the stack. A component is emitted only
+	// after every component that references it, so referencers are deleted first and packages referencing each other
+	// stay in one group, the only way ObjectTools deletes them without finding a reference outside the batch.
+	TArray<int32> NodeOrder;
+	NodeOrder.Init(INDEX_NONE, NumNodes);
+	TArray<int32> LowLink;
+	LowLink.SetNumUninitialized(NumNodes);
+	TBitArray<> OnStack(false, NumNodes);
+	TArray<int32> NodeStack;
+
+	struct FFrame
+	{
+		int32 Node;
+		int32 NextEdge;
+	};
+	TArray<FFrame> Frames;
+
+	int32 NextOrder = 0;
+	for (int32 RootNode = 0; RootNode < NumNodes; ++RootNode)
+	{
+		if (NodeOrder[ RootNode ] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		NodeOrder[ RootNode ] = LowLink[ RootNode ] = NextOrder++;
+		NodeStack.Push(RootNode);
+		OnStack[ RootNode ] = true;
+		Frames.Push({ RootNode, 0 });
+
+		while (!Frames.IsEmpty())
+		{
+			const int32 Node = Frames.Last().Node;
+			if (Frames.Last().NextEdge < ReferencerNodes[ Node ].Num())
+			{
+				const int32 NextNode = ReferencerNodes[ Node ][ Frames.Last().NextEdge++ ];
+				if (NodeOrder[ NextNode ] == INDEX_NONE)
+				{
+					NodeOrder[ NextNode ] = LowLink[ NextNode ] = NextOrder++;
+					NodeStack.Push(NextNode);
+					OnStack[ NextNode ] = true;
+					Frames.Push({ NextNode, 0 });
+				}
+				else if (OnStack[ NextNode ])
+				{
+					LowLink[ Node ] = FMath::Min(LowLink[ Node ], NodeOrder[ NextNode ]);
+				}
+				continue;
+			}
+
+			Frames.Pop(false);
+			if (!Frames.IsEmpty())
+			{
+				LowLink[ Frames.Last().Node ] = FMath::Min(LowLink[ Frames.Last().Node ], LowLink[ Node ]);
+			}
+
+			if (LowLink[ Node ] == NodeOrder[ Node ])
+			{
+				TArray<FAssetData>& DeletionGroup = OutDeletionGroups.AddDefaulted_GetRef();
+				int32 ComponentNode = INDEX_NONE;
+				do
+				{
+					ComponentNode = NodeStack.Pop(false);
+					OnStack[ ComponentNode ] = false;
+					DeletionGroup.Append(MoveTemp(AssetsByNode[ ComponentNode ]));
+				}
+				while (ComponentNode != Node);
+			}
+		}
+	}
+}
+void FAssetBatchDeletion::SplitIntoBatches(const TArray<TArray<FAssetData>>& DeletionGroups, TArray<TArray<FAssetData>>& OutBatches)
+{
+	const UAssetDeletionSettings* Settings = GetDefault<UAssetDeletionSettings>();
+	const int32 MaxBatchSize = Settings->DeletionBatchSize > 0 ? Settings->DeletionBatchSize : MAX_int32;
+	const int64 MemoryBudget = Settings->DeletionBatchMemoryBudgetMB > 0 ? int64(Settings->DeletionBatchMemoryBudgetMB) * 1024 * 1024 : MAX_int64;
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	// Groups are never split, a group over the limits becomes a batch of its own
+	int64 BatchMemory = 0;
+	for (const TArray<FAssetData>& DeletionGroup : DeletionGroups)
+	{
+		int64 GroupMemory = 0;
+		if (MemoryBudget != MAX_int64)
+		{
+			for (const FAssetData& AssetData : DeletionGroup)
+			{
+				const TOptional<FAssetPackageData> PackageData = AssetRegistryModule.Get().GetAssetPackageDataCopy(AssetData.PackageName);
+				GroupMemory += PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+			}
+		}
+
+		const bool bBatchFull = !OutBatches.IsEmpty() && (OutBatches.Last().Num() + DeletionGroup.Num() > MaxBatchSize || BatchMemory + GroupMemory > MemoryBudget);
+		if (OutBatches.IsEmpty() || bBatchFull)
+		{
+			OutBatches.AddDefaulted();
+			BatchMemory = 0;
+		}
+
+		OutBatches.Last().Append(DeletionGroup);
+		BatchMemory += GroupMemory;
+	}
+}
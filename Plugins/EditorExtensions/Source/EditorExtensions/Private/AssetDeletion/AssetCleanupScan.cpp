@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetCleanupScan.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+TSharedRef<FAssetCleanupScan> FAssetCleanupScan::Launch(const FText& InTitle, TUniqueFunction<void(FAssetScanProgress&)>&& ScanWork, TUniqueFunction<void()>&& InOnCompleted)
+{
+	TSharedRef<FAssetCleanupScan> Scan = MakeShared<FAssetCleanupScan>();
+	Scan->Title = InTitle;
+	Scan->OnCompleted = MoveTemp(InOnCompleted);
+
+	FNotificationInfo NotifyInfo(InTitle);
+	NotifyInfo.bUseLargeFont = true;
+	NotifyInfo.bFireAndForget = false;
+	NotifyInfo.FadeOutDuration = 3.f;
+	NotifyInfo.ButtonDetails.Add(FNotificationButtonInfo(
+		FText::FromString(TEXT("Cancel")),
+		FText::FromString(TEXT("Stop the scan, nothing will be deleted")),
+		FSimpleDelegate::CreateSP(Scan, &FAssetCleanupScan::Cancel),
+		SNotificationItem::CS_Pending));
+
+	Scan->Notification = FSlateNotificationManager::Get().AddNotification(NotifyInfo);
+	if (Scan->Notification.IsValid())
+	{
+		Scan->Notification->SetCompletionState(SNotificationItem::CS_Pending);
+	}
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(Scan, &FAssetCleanupScan::TickProgress), 0.1f);
+
+	Async(EAsyncExecution::ThreadPool, [Scan, ScanWork = MoveTemp(ScanWork)]() mutable
+	{
+		ScanWork(Scan->Progress);
+		Scan->bWorkDone = true;
+	});
+
+	return Scan;
+}
+void FAssetCleanupScan::Cancel()
+{
+	Progress.RequestCancel();
+
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::FromString(Title.ToString() + TEXT(" - cancelling")));
+	}
+}
+bool FAssetCleanupScan::TickProgress(float DeltaTime)
+{
+	if (bWorkDone)
+	{
+		Finish();
+		return false;
+	}
+
+	if (Notification.IsValid() && !Progress.IsCancelRequested() && Progress.GetTotal() > 0)
+	{
+		Notification->SetText(FText::FromString(FString::Printf(TEXT("%s (%d / %d)"), *Title.ToString(), Progress.GetCompleted(), Progress.GetTotal())));
+	}
+	return true;
+}
+void FAssetCleanupScan::Finish()
+{
+	const bool bCancelled = Progress.IsCancelRequested();
+	if (Notification.IsValid())
+	{
+		Notification->SetText(FText::FromString(Title.ToString() + (bCancelled ? TEXT(" - cancelled") : TEXT(" - done"))));
+		Notification->SetCompletionState(bCancelled ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+		Notification->ExpireAndFadeout();
+		Notification.Reset();
+	}
+
+	// Still running while the completion callback is, its delete and confirm dialogs must not let another scan
+	// start against the assets it is about to delete
+	if (!bCancelled && OnCompleted)
+	{
+		OnCompleted();
+	}
+	OnCompleted.Reset();
+
+	bFinished = true;
+}
@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetContentHasher.h"
+
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetScanCache.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Serialization/ArchiveProxy.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace AssetContentHasher
+{
+	constexpr int64 ReadBlockSize = 1024 * 1024;
+
+	// Stands in for the package's own long and short name, the only names a renamed copy changes
+	const TCHAR* OwnNamePlaceholder = TEXT("<self>");
+
+	// Reads names serialized as name table indices, the way the linker does
+	class FNameTableReader : public FArchiveProxy
+	{
+	public:
+		FNameTableReader(FArchive& InInnerArchive, const TArray<FName>& InNameTable)
+			: FArchiveProxy(InInnerArchive)
+			, NameTable(InNameTable)
+		{
+		}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 NameIndex = 0;
+			int32 Number = 0;
+			InnerArchive << NameIndex << Number;
+
+			if (!NameTable.IsValidIndex(NameIndex))
+			{
+				SetError();
+				Name = NAME_None;
+				return *this;
+			}
+			Name = FName(NameTable[ NameIndex ], Number);
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& NameTable;
+	};
+
+	void HashText(FXxHash64Builder& HashBuilder, const FString& Text)
+	{
+		// Length first, so neighbouring strings can't run into each other
+		const int32 TextLength = Text.Len();
+		HashBuilder.Update(&TextLength, sizeof(TextLength));
+		HashBuilder.Update(*Text, TextLength * sizeof(TCHAR));
+	}
+
+	FString GetImportPath(const TArray<FObjectImport>& Imports, const int32 ImportIndex)
+	{
+		FString ImportPath = Imports[ ImportIndex ].ObjectName.ToString();
+
+		// Bounded by the table size, a corrupt outer chain can't loop forever
+		FPackageIndex OuterIndex = Imports[ ImportIndex ].OuterIndex;
+		for (int32 Depth = 0; Depth < Imports.Num() && !OuterIndex.IsNull(); ++Depth)
+		{
+			if (!OuterIndex.IsImport() || !Imports.IsValidIndex(OuterIndex.ToImport()))
+			{
+				return OwnNamePlaceholder + FString(TEXT(":")) + ImportPath;
+			}
+
+			const FObjectImport& OuterImport = Imports[ OuterIndex.ToImport() ];
+			ImportPath = OuterImport.ObjectName.ToString() + TEXT(".") + ImportPath;
+			OuterIndex = OuterImport.OuterIndex;
+		}
+		return ImportPath;
+	}
+
+	bool HashPackageHeader(FArchive& Reader, const FPackageFileSummary& Summary, const FName PackageName, FXxHash64Builder& HashBuilder)
+	{
+		if (Summary.NameCount < 0 || Summary.ImportCount < 0 || (Summary.NameCount > 0 && Summary.NameOffset <= 0) || (Summary.ImportCount > 0 && Summary.ImportOffset <= 0))
+		{
+			return false;
+		}
+
+		// Names and imports are read with the versions the package was saved with
+		Reader.SetUEVer(Summary.GetFileVersionUE());
+		Reader.SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+		Reader.SetEngineVer(Summary.SavedByEngineVersion);
+		Reader.SetCustomVersions(Summary.GetCustomVersionContainer());
+
+		const FString OwnLongName = PackageName.ToString();
+		const FString OwnShortName = FPackageName::GetShortName(OwnLongName);
+
+		// Export data refers to names by table index, so the table is hashed in order
+		TArray<FName> NameTable;
+		NameTable.Reserve(Summary.NameCount);
+		Reader.Seek(Summary.NameOffset);
+		for (int32 NameIndex = 0; NameIndex < Summary.NameCount; ++NameIndex)
+		{
+			FNameEntrySerialized NameEntry(ENAME_LinkerConstructor);
+			Reader << NameEntry;
+			if (Reader.IsError())
+			{
+				return false;
+			}
+
+			const FName Name(NameEntry);
+			NameTable.Add(Name);
+
+			const FString NameText = Name.ToString();
+			const bool bIsOwnName = NameText.Equals(OwnLongName, ESearchCase::IgnoreCase) || NameText.Equals(OwnShortName, ESearchCase::IgnoreCase);
+			HashText(HashBuilder, bIsOwnName ? OwnNamePlaceholder : NameText);
+		}
+
+		TArray<FObjectImport> Imports;
+		Imports.SetNum(Summary.ImportCount);
+		Reader.Seek(Summary.ImportOffset);
+		FNameTableReader ImportReader(Reader, NameTable);
+		for (FObjectImport& Import : Imports)
+		{
+			ImportReader << Import;
+		}
+		if (ImportReader.IsError() || Reader.IsError())
+		{
+			return false;
+		}
+
+		for (int32 ImportIndex = 0; ImportIndex < Imports.Num(); ++ImportIndex)
+		{
+			const FObjectImport& Import = Imports[ ImportIndex ];
+			HashText(HashBuilder, Import.ClassPackage.ToString());
+			HashText(HashBuilder, Import.ClassName.ToString());
+			HashText(HashBuilder, GetImportPath(Imports, ImportIndex));
+		}
+		return true;
+	}
+}
+
+bool FAssetContentHasher::HashPackages(const TArray<FName>& PackageNames, TMap<FName, uint64>& OutPackageHashes, FAssetScanProgress* Progress,
+	const FAssetScanCache* Cache, TMap<FName, FAssetScanCacheEntry>* OutNewCacheEntries)
+{
+	const int32 NumPackages = PackageNames.Num();
+	if (Progress)
+	{
+		Progress->SetTotal(NumPackages);
+	}
+
+	// One slot per package, so workers never write to the same element
+	TArray<uint64> PackageHashes;
+	PackageHashes.SetNumZeroed(NumPackages);
+	TArray<uint8> HashedPackages;
+	HashedPackages.SetNumZeroed(NumPackages);
+	TArray<FAssetScanCacheEntry> NewCacheEntries;
+	NewCacheEntries.SetNum(NumPackages);
+
+	const int32 NumChunks = FMath::Clamp(GetDefault<UAssetDeletionSettings>()->GetScanWorkerCount(), 1, FMath::Max(NumPackages, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumPackages, NumChunks);
+
+	ParallelFor(
+		NumChunks,
+		[&](const int32 ChunkIndex)
+		{
+			const int32 FirstPackage = ChunkIndex * ChunkSize;
+			const int32 LastPackage = FMath::Min(FirstPackage + ChunkSize, NumPackages);
+
+			TArray<uint8> ReadBuffer;
+			for (int32 PackageIndex = FirstPackage; PackageIndex < LastPackage; ++PackageIndex)
+			{
+				if (Progress)
+				{
+					if (Progress->IsCancelRequested())
+					{
+						return;
+					}
+					Progress->Advance();
+				}
+
+				FString Filename;
+				FFileStatData StatData;
+				if (!FindPackageFile(PackageNames[ PackageIndex ], Filename, StatData))
+				{
+					continue;
+				}
+
+				const FAssetScanCacheEntry* CachedEntry = Cache ? Cache->FindValid(PackageNames[ PackageIndex ], StatData) : nullptr;
+				if (CachedEntry && EnumHasAnyFlags(CachedEntry->ValidFields, EAssetScanCacheField::ContentHash))
+				{
+					PackageHashes[ PackageIndex ] = CachedEntry->ContentHash;
+					HashedPackages[ PackageIndex ] = true;
+					continue;
+				}
+
+				if (HashPackageFile(PackageNames[ PackageIndex ], Filename, ReadBuffer, PackageHashes[ PackageIndex ]))
+				{
+					HashedPackages[ PackageIndex ] = true;
+
+					FAssetScanCacheEntry& NewEntry = NewCacheEntries[ PackageIndex ];
+					NewEntry.FileSize = StatData.FileSize;
+					NewEntry.ModifiedTicks = StatData.ModificationTime.GetTicks();
+					NewEntry.ValidFields = EAssetScanCacheField::ContentHash;
+					NewEntry.ContentHash = PackageHashes[ PackageIndex ];
+				}
+			}
+		},
+		NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+	if (Progress && Progress->IsCancelRequested())
+	{
+		return false;
+	}
+
+	OutPackageHashes.Reserve(OutPackageHashes.Num() + NumPackages);
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		if (!HashedPackages[ PackageIndex ])
+		{
+			continue;
+		}
+
+		OutPackageHashes.Add(PackageNames[ PackageIndex ], PackageHashes[ PackageIndex ]);
+		if (OutNewCacheEntries && NewCacheEntries[ PackageIndex ].ValidFields != EAssetScanCacheField::None)
+		{
+			OutNewCacheEntries->Add(PackageNames[ PackageIndex ], NewCacheEntries[ PackageIndex ]);
+		}
+	}
+	return true;
+}
+bool FAssetContentHasher::FindPackageFile(const FName PackageName, FString& OutFilename, FFileStatData& OutStatData)
+{
+	FString BaseFilename;
+	if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), BaseFilename))
+	{
+		return false;
+	}
+
+	for (const FString& Extension : { FPackageName::GetAssetPackageExtension(), FPackageName::GetMapPackageExtension() })
+	{
+		OutFilename = BaseFilename + Extension;
+		OutStatData = IFileManager::Get().GetStatData(*OutFilename);
+		if (OutStatData.bIsValid && !OutStatData.bIsDirectory)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+bool FAssetContentHasher::HashPackageFile(const FName PackageName, const FString& Filename, TArray<uint8>& ReadBuffer, uint64& OutHash)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	FPackageFileSummary Summary;
+	*Reader << Summary;
+	if (Reader->IsError() || Summary.Tag != PACKAGE_FILE_TAG || Summary.TotalHeaderSize <= 0)
+	{
+		return false;
+	}
+
+	FXxHash64Builder HashBuilder;
+	if (!AssetContentHasher::HashPackageHeader(*Reader, Summary, PackageName, HashBuilder))
+	{
+		return false;
+	}
+
+	const int64 FileSize = Reader->TotalSize();
+	int64 Offset = FMath::Min<int64>(Summary.TotalHeaderSize, FileSize);
+	Reader->Seek(Offset);
+
+	ReadBuffer.SetNumUninitialized(AssetContentHasher::ReadBlockSize, false);
+
+	while (Offset < FileSize)
+	{
+		const int64 BlockSize = FMath::Min(AssetContentHasher::ReadBlockSize, FileSize - Offset);
+		Reader->Serialize(ReadBuffer.GetData(), BlockSize);
+		if (Reader->IsError())
+		{
+			return false;
+		}
+
+		HashBuilder.Update(ReadBuffer.GetData(), BlockSize);
+		Offset += BlockSize;
+	}
+
+	OutHash = HashBuilder.Finalize().Hash;
+	return true;
+}
@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetDeletionSettings.h"
+
+#include "Async/TaskGraphInterfaces.h"
+
+int32 UAssetDeletionSettings::GetScanWorkerCount() const
+{
+	if (ScanWorkerCount > 0)
+	{
+		return ScanWorkerCount;
+	}
+	return FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+}
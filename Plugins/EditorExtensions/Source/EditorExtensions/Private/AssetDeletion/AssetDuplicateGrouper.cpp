@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetDuplicateGrouper.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+
+namespace AssetDuplicateGrouper
+{
+	template <typename KeyType, typename GetKeyFunc>
+	void GroupByKey(const TArray<TSharedPtr<FAssetData>>& Assets, TArray<FAssetDuplicateGroup>& OutGroups, GetKeyFunc GetKey)
+	{
+		TMap<KeyType, int32> GroupIndexByKey;
+		GroupIndexByKey.Reserve(Assets.Num());
+
+		for (const TSharedPtr<FAssetData>& Data : Assets)
+		{
+			if (!Data.IsValid())
+			{
+				continue;
+			}
+
+			KeyType Key;
+			if (!GetKey(*Data, Key))
+			{
+				continue;
+			}
+
+			int32& GroupIndex = GroupIndexByKey.FindOrAdd(Key, INDEX_NONE);
+			if (GroupIndex == INDEX_NONE)
+			{
+				GroupIndex = OutGroups.AddDefaulted();
+			}
+			OutGroups[ GroupIndex ].Assets.Add(Data);
+		}
+	}
+
+	int32 FindClusterRoot(TArray<int32>& ClusterParents, int32 Index)
+	{
+		while (ClusterParents[ Index ] != Index)
+		{
+			ClusterParents[ Index ] = ClusterParents[ ClusterParents[ Index ] ];
+			Index = ClusterParents[ Index ];
+		}
+		return Index;
+	}
+}
+
+void FAssetDuplicateGrouper::GroupByName(const TArray<TSharedPtr<FAssetData>>& Assets, TArray<FAssetDuplicateGroup>& OutGroups)
+{
+	OutGroups.Reset();
+
+	// FName keys hash and compare by index, no string is built per asset
+	AssetDuplicateGrouper::GroupByKey<FName>(Assets, OutGroups, [](const FAssetData& Data, FName& OutKey)
+	{
+		OutKey = Data.AssetName;
+		return true;
+	});
+	FinishGroups(OutGroups);
+}
+void FAssetDuplicateGrouper::GroupByContentHash(const TArray<TSharedPtr<FAssetData>>& Assets, const TMap<FName, uint64>& PackageHashes, TArray<FAssetDuplicateGroup>& OutGroups)
+{
+	OutGroups.Reset();
+
+	AssetDuplicateGrouper::GroupByKey<uint64>(Assets, OutGroups, [&PackageHashes](const FAssetData& Data, uint64& OutKey)
+	{
+		const uint64* ContentHash = PackageHashes.Find(Data.PackageName);
+		if (!ContentHash)
+		{
+			return false;
+		}
+		OutKey = *ContentHash;
+		return true;
+	});
+	FinishGroups(OutGroups);
+}
+void FAssetDuplicateGrouper::GroupByNearHash(const TArray<TSharedPtr<FAssetData>>& Assets, const TMap<FName, uint64>& PackageHashes, const int32 MaxHammingDistance, TArray<FAssetDuplicateGroup>& OutGroups)
+{
+	using namespace AssetDuplicateGrouper;
+
+	OutGroups.Reset();
+
+	TArray<uint64> UniqueHashes;
+	TMap<uint64, int32> HashIndices;
+	for (const TPair<FName, uint64>& PackageHash : PackageHashes)
+	{
+		if (!HashIndices.Contains(PackageHash.Value))
+		{
+			HashIndices.Add(PackageHash.Value, UniqueHashes.Add(PackageHash.Value));
+		}
+	}
+
+	TArray<int32> ClusterParents;
+	ClusterParents.SetNumUninitialized(UniqueHashes.Num());
+	for (int32 HashIndex = 0; HashIndex < UniqueHashes.Num(); ++HashIndex)
+	{
+		ClusterParents[ HashIndex ] = HashIndex;
+	}
+
+	// Two hashes within MaxHammingDistance bits of each other agree exactly on at least one of MaxHammingDistance + 1
+	// bands, so only hashes sharing a band value are compared instead of every pair
+	const int32 NumBands = FMath::Clamp(MaxHammingDistance + 1, 1, 8);
+	for (int32 BandIndex = 0; BandIndex < NumBands; ++BandIndex)
+	{
+		const int32 FirstBit = BandIndex * 64 / NumBands;
+		const int32 NumBits = (BandIndex + 1) * 64 / NumBands - FirstBit;
+		const uint64 BandMask = NumBits == 64 ? MAX_uint64 : (uint64(1) << NumBits) - 1;
+
+		TMap<uint64, TArray<int32>> HashesByBand;
+		for (int32 HashIndex = 0; HashIndex < UniqueHashes.Num(); ++HashIndex)
+		{
+			HashesByBand.FindOrAdd((UniqueHashes[ HashIndex ] >> FirstBit) & BandMask).Add(HashIndex);
+		}
+
+		for (const TPair<uint64, TArray<int32>>& Band : HashesByBand)
+		{
+			const TArray<int32>& Candidates = Band.Value;
+			for (int32 First = 0; First < Candidates.Num(); ++First)
+			{
+				for (int32 Second = First + 1; Second < Candidates.Num(); ++Second)
+				{
+					const uint64 DifferingBits = UniqueHashes[ Candidates[ First ] ] ^ UniqueHashes[ Candidates[ Second ] ];
+					if (FMath::CountBits(DifferingBits) <= MaxHammingDistance)
+					{
+						ClusterParents[ FindClusterRoot(ClusterParents, Candidates[ Second ]) ] = FindClusterRoot(ClusterParents, Candidates[ First ]);
+					}
+				}
+			}
+		}
+	}
+
+	GroupByKey<int32>(Assets, OutGroups, [&](const FAssetData& Data, int32& OutKey)
+	{
+		const uint64* PackageHash = PackageHashes.Find(Data.PackageName);
+		if (!PackageHash)
+		{
+			return false;
+		}
+		OutKey = FindClusterRoot(ClusterParents, HashIndices.FindChecked(*PackageHash));
+		return true;
+	});
+	FinishGroups(OutGroups);
+}
+void FAssetDuplicateGrouper::FinishGroups(TArray<FAssetDuplicateGroup>& InOutGroups)
+{
+	InOutGroups.RemoveAll([](const FAssetDuplicateGroup& Group)
+	{
+		return Group.Assets.Num() < 2;
+	});
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	for (FAssetDuplicateGroup& Group : InOutGroups)
+	{
+		Group.TotalDiskSize = 0;
+		for (const TSharedPtr<FAssetData>& Data : Group.Assets)
+		{
+			const TOptional<FAssetPackageData> PackageData = AssetRegistryModule.Get().GetAssetPackageDataCopy(Data->PackageName);
+			if (PackageData.IsSet() && PackageData->DiskSize > 0)
+			{
+				Group.TotalDiskSize += PackageData->DiskSize;
+			}
+		}
+	}
+}
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetExclusionMatcher.h"
+
+void FAssetExclusionMatcher::Compile(const TArray<FAssetExclusionRule>& Rules)
+{
+	PrefixNodes.Reset();
+	PrefixNodes.AddDefaulted();
+	ExcludedSegments.Reset();
+	GlobPatterns.Reset();
+
+	for (const FAssetExclusionRule& Rule : Rules)
+	{
+		FString Pattern = Rule.Pattern.TrimStartAndEnd().Replace(TEXT("\\"), TEXT("/"));
+		Pattern.RemoveFromEnd(TEXT("/"));
+		if (Pattern.IsEmpty())
+		{
+			continue;
+		}
+
+		switch (Rule.RuleType)
+		{
+		case E_AssetExclusionRuleType::EAER_Prefix:
+		{
+			TArray<FString> Segments;
+			Pattern.ParseIntoArray(Segments, TEXT("/"));
+
+			int32 NodeIndex = 0;
+			for (FString& Segment : Segments)
+			{
+				int32* ChildIndex = PrefixNodes[ NodeIndex ].Children.Find(Segment);
+				if (ChildIndex)
+				{
+					NodeIndex = *ChildIndex;
+					continue;
+				}
+
+				const int32 NewNodeIndex = PrefixNodes.AddDefaulted();
+				PrefixNodes[ NodeIndex ].Children.Add(MoveTemp(Segment), NewNodeIndex);
+				NodeIndex = NewNodeIndex;
+			}
+			PrefixNodes[ NodeIndex ].bIsRuleEnd = NodeIndex != 0;
+			break;
+		}
+		case E_AssetExclusionRuleType::EAER_Segment:
+			ExcludedSegments.Add(Pattern.Replace(TEXT("/"), TEXT("")));
+			break;
+		case E_AssetExclusionRuleType::EAER_Glob:
+			GlobPatterns.Add(Pattern);
+			break;
+		}
+	}
+}
+bool FAssetExclusionMatcher::IsFolderExcluded(const FString& FolderPath) const
+{
+	TArray<FString> Segments;
+	FolderPath.ParseIntoArray(Segments, TEXT("/"));
+
+	// FString map keys and set elements compare case insensitively, same as package paths
+	int32 NodeIndex = PrefixNodes.IsEmpty() ? INDEX_NONE : 0;
+	for (const FString& Segment : Segments)
+	{
+		if (ExcludedSegments.Contains(Segment))
+		{
+			return true;
+		}
+
+		if (NodeIndex != INDEX_NONE)
+		{
+			const int32* ChildIndex = PrefixNodes[ NodeIndex ].Children.Find(Segment);
+			NodeIndex = ChildIndex ? *ChildIndex : INDEX_NONE;
+
+			if (NodeIndex != INDEX_NONE && PrefixNodes[ NodeIndex ].bIsRuleEnd)
+			{
+				return true;
+			}
+		}
+	}
+
+	for (const FString& GlobPattern : GlobPatterns)
+	{
+		if (FolderPath.MatchesWildcard(GlobPattern))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+int32 FAssetExclusionMatcher::RemoveExcludedAssets(TArray<FAssetData>& InOutAssets) const
+{
+	// Assets come grouped by folder, each folder is matched once
+	TMap<FName, bool> FolderResults;
+
+	return InOutAssets.RemoveAll([this, &FolderResults](const FAssetData& AssetData)
+	{
+		if (const bool* bCachedResult = FolderResults.Find(AssetData.PackagePath))
+		{
+			return *bCachedResult;
+		}
+		return FolderResults.Add(AssetData.PackagePath, IsFolderExcluded(AssetData.PackagePath.ToString()));
+	});
+}
+int32 FAssetExclusionMatcher::RemoveExcludedFolders(TArray<FString>& InOutFolderPaths) const
+{
+	return InOutFolderPaths.RemoveAll([this](const FString& FolderPath)
+	{
+		return IsFolderExcluded(FolderPath);
+	});
+}
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetFileStatScan.h"
+
+#include "AssetDeletion/AssetContentHasher.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+void FAssetFileStatScan::Launch(TArray<FName>&& PackageNames, const TSharedRef<FAssetScanProgress>& Progress, TFunction<void(FBatch&&)>&& OnBatchDone)
+{
+	Progress->SetTotal(PackageNames.Num());
+
+	const int32 NumWorkers = GetDefault<UAssetDeletionSettings>()->GetScanWorkerCount();
+	Async(EAsyncExecution::ThreadPool, [PackageNames = MoveTemp(PackageNames), Progress, OnBatchDone = MoveTemp(OnBatchDone), NumWorkers]()
+	{
+		const int32 NumPackages = PackageNames.Num();
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumPackages, BatchSize);
+		const int32 NumChunks = FMath::Clamp(NumWorkers, 1, FMath::Max(NumBatches, 1));
+
+		// Chunks take every NumChunks-th batch, so the first batches of every chunk, the top of the list, come back first
+		ParallelFor(
+			NumChunks,
+			[&](const int32 ChunkIndex)
+			{
+				for (int32 BatchIndex = ChunkIndex; BatchIndex < NumBatches; BatchIndex += NumChunks)
+				{
+					if (Progress->IsCancelRequested())
+					{
+						return;
+					}
+
+					FBatch Batch;
+					Batch.FirstIndex = BatchIndex * BatchSize;
+					const int32 LastIndex = FMath::Min(Batch.FirstIndex + BatchSize, NumPackages);
+					Batch.FileSizes.Reserve(LastIndex - Batch.FirstIndex);
+					Batch.ModifiedTicks.Reserve(LastIndex - Batch.FirstIndex);
+
+					for (int32 PackageIndex = Batch.FirstIndex; PackageIndex < LastIndex; ++PackageIndex)
+					{
+						FString Filename;
+						FFileStatData StatData;
+						const bool bFound = FAssetContentHasher::FindPackageFile(PackageNames[ PackageIndex ], Filename, StatData);
+						Batch.FileSizes.Add(bFound ? StatData.FileSize : INDEX_NONE);
+						Batch.ModifiedTicks.Add(bFound ? StatData.ModificationTime.GetTicks() : 0);
+					}
+
+					// Counted once delivered, so a complete Progress means no batch is left in the game thread queue
+					AsyncTask(ENamedThreads::GameThread, [Progress, OnBatchDone, Batch = MoveTemp(Batch)]() mutable
+					{
+						if (!Progress->IsCancelRequested())
+						{
+							const int32 NumStatted = Batch.FileSizes.Num();
+							OnBatchDone(MoveTemp(Batch));
+							Progress->Advance(NumStatted);
+						}
+					});
+				}
+			},
+			NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+	});
+}
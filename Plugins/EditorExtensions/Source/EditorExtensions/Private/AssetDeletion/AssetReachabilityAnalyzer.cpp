@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetReachabilityAnalyzer.h"
+
+#include "AssetActions/AssetFolderEnumerator.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetReferenceIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameMapsSettings.h"
+#include "Settings/ProjectPackagingSettings.h"
+#include "UObject/UnrealType.h"
+
+namespace AssetReachabilityAnalyzer
+{
+	// Every soft object and class path a config object holds, including those in arrays and structs
+	void CollectSoftPathPackages(const UObject* ConfigObject, TArray<FName>& OutPackages)
+	{
+		for (TPropertyValueIterator<FProperty> It(ConfigObject->GetClass(), ConfigObject, EPropertyValueIteratorFlags::FullRecursion); It; ++It)
+		{
+			FSoftObjectPath SoftPath;
+			if (const FStructProperty* StructProperty = CastField<FStructProperty>(It.Key()))
+			{
+				if (!StructProperty->Struct->IsChildOf(TBaseStructure<FSoftObjectPath>::Get()))
+				{
+					continue;
+				}
+				SoftPath = *static_cast<const FSoftObjectPath*>(It.Value());
+				It.SkipRecursiveProperty();
+			}
+			else if (CastField<FSoftObjectProperty>(It.Key()))
+			{
+				SoftPath = static_cast<const FSoftObjectPtr*>(It.Value())->ToSoftObjectPath();
+			}
+
+			if (SoftPath.IsValid())
+			{
+				OutPackages.Add(SoftPath.GetLongPackageFName());
+			}
+		}
+	}
+}
+
+void FAssetReachabilityAnalyzer::Analyze(const FAssetReferenceIndex& ReferenceIndex)
+{
+	ReachablePackages.Reset();
+
+	TArray<FName> PackagesToVisit;
+	CollectRootPackages(PackagesToVisit);
+
+	const TMap<FName, TArray<FName>>& PackageDependencies = ReferenceIndex.GetPackageDependencies();
+	ReachablePackages.Reserve(PackageDependencies.Num());
+
+	// Each package is marked and expanded at most once
+	while (!PackagesToVisit.IsEmpty())
+	{
+		const FName PackageName = PackagesToVisit.Pop(false);
+
+		bool bAlreadyReachable = false;
+		ReachablePackages.Add(PackageName, &bAlreadyReachable);
+		if (bAlreadyReachable)
+		{
+			continue;
+		}
+
+		if (const TArray<FName>* Dependencies = PackageDependencies.Find(PackageName))
+		{
+			PackagesToVisit.Append(*Dependencies);
+		}
+	}
+}
+bool FAssetReachabilityAnalyzer::IsPackageReachable(const FName PackageName) const
+{
+	return ReachablePackages.Contains(PackageName);
+}
+void FAssetReachabilityAnalyzer::FilterUnreachableAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnreachableAssets) const
+{
+	for (const FAssetData& AssetData : AssetsToFilter)
+	{
+		if (!IsPackageReachable(AssetData.PackageName))
+		{
+			OutUnreachableAssets.Add(AssetData);
+		}
+	}
+}
+void FAssetReachabilityAnalyzer::FilterUnreachableAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnreachableAssets) const
+{
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsToFilter)
+	{
+		if (AssetData.IsValid() && !IsPackageReachable(AssetData->PackageName))
+		{
+			OutUnreachableAssets.Add(AssetData);
+		}
+	}
+}
+void FAssetReachabilityAnalyzer::CollectRootPackages(TArray<FName>& OutRootPackages)
+{
+	const UAssetDeletionSettings* Settings = GetDefault<UAssetDeletionSettings>();
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FAssetData> RootAssets;
+
+	if (Settings->bMapsAreRoots)
+	{
+		AssetRegistryModule.Get().GetAssetsByClass(UWorld::StaticClass()->GetClassPathName(), RootAssets);
+	}
+
+	TArray<FDirectoryPath> RootDirectories = Settings->AdditionalRootDirectories;
+	if (Settings->bAlwaysCookDirectoriesAreRoots)
+	{
+		RootDirectories.Append(GetDefault<UProjectPackagingSettings>()->DirectoriesToAlwaysCook);
+	}
+	TArray<FString> RootDirectoryPaths;
+	for (const FDirectoryPath& RootDirectory : RootDirectories)
+	{
+		if (!RootDirectory.Path.IsEmpty())
+		{
+			RootDirectoryPaths.Add(RootDirectory.Path);
+		}
+	}
+	FAssetFolderEnumerator::GetAssetsUnderFolders(RootDirectoryPaths, RootAssets);
+
+	for (const FAssetData& RootAsset : RootAssets)
+	{
+		OutRootPackages.Add(RootAsset.PackageName);
+	}
+
+	// Maps & Modes and the engine's default classes are only referenced from config
+	if (Settings->bConfigAssetsAreRoots)
+	{
+		AssetReachabilityAnalyzer::CollectSoftPathPackages(GetDefault<UGameMapsSettings>(), OutRootPackages);
+		if (GEngine)
+		{
+			AssetReachabilityAnalyzer::CollectSoftPathPackages(GEngine, OutRootPackages);
+		}
+	}
+
+	for (const FSoftObjectPath& RootAssetPath : Settings->AdditionalRootAssets)
+	{
+		if (RootAssetPath.IsValid())
+		{
+			OutRootPackages.Add(RootAssetPath.GetLongPackageFName());
+		}
+	}
+
+	if (Settings->bPrimaryAssetsAreRoots && UAssetManager::IsInitialized())
+	{
+		const UAssetManager& AssetManager = UAssetManager::Get();
+
+		TArray<FPrimaryAssetTypeInfo> PrimaryAssetTypes;
+		AssetManager.GetPrimaryAssetTypeInfoList(PrimaryAssetTypes);
+
+		TArray<FPrimaryAssetId> PrimaryAssetIds;
+		for (const FPrimaryAssetTypeInfo& PrimaryAssetType : PrimaryAssetTypes)
+		{
+			PrimaryAssetIds.Reset();
+			AssetManager.GetPrimaryAssetIdList(PrimaryAssetType.PrimaryAssetType, PrimaryAssetIds);
+
+			for (const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+			{
+				const FSoftObjectPath PrimaryAssetPath = AssetManager.GetPrimaryAssetPath(PrimaryAssetId);
+				if (PrimaryAssetPath.IsValid())
+				{
+					OutRootPackages.Add(PrimaryAssetPath.GetLongPackageFName());
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetReferenceIndex.h"
+
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+
+bool FAssetReferenceIndex::Build(FAssetScanProgress* Progress)
+{
+	Reset();
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	const IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	// Dependencies are only gathered for packages on disk, which also keeps this safe to run off the game thread
+	TSet<FName> UniquePackageNames;
+	AssetRegistry.EnumerateAllAssets([&UniquePackageNames](const FAssetData& AssetData)
+	{
+		UniquePackageNames.Add(AssetData.PackageName);
+		return true;
+	}, true);
+	const TArray<FName> PackageNames = UniquePackageNames.Array();
+	const int32 NumPackages = PackageNames.Num();
+
+	if (Progress)
+	{
+		Progress->SetTotal(NumPackages);
+	}
+
+	// Registry reads are thread safe. Each chunk only writes its own slice of results, so the merge below is deterministic.
+	TArray<TArray<FName>> DependenciesPerPackage;
+	DependenciesPerPackage.SetNum(NumPackages);
+
+	const int32 NumChunks = FMath::Clamp(GetDefault<UAssetDeletionSettings>()->GetScanWorkerCount(), 1, FMath::Max(NumPackages, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumPackages, NumChunks);
+
+	ParallelFor(
+		NumChunks,
+		[&](const int32 ChunkIndex)
+		{
+			const int32 FirstPackage = ChunkIndex * ChunkSize;
+			const int32 LastPackage = FMath::Min(FirstPackage + ChunkSize, NumPackages);
+			for (int32 PackageIndex = FirstPackage; PackageIndex < LastPackage; ++PackageIndex)
+			{
+				if (Progress && Progress->IsCancelRequested())
+				{
+					return;
+				}
+
+				QueryDependencies(AssetRegistry, PackageNames[ PackageIndex ], DependenciesPerPackage[ PackageIndex ]);
+
+				if (Progress)
+				{
+					Progress->Advance();
+				}
+			}
+		},
+		NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+	if (Progress && Progress->IsCancelRequested())
+	{
+		return false;
+	}
+
+	PackageDependencies.Reserve(NumPackages);
+	ReferencerCounts.Reserve(NumPackages);
+
+	// Invert forward dependencies in package order
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages; ++PackageIndex)
+	{
+		AddReferences(DependenciesPerPackage[ PackageIndex ]);
+		PackageDependencies.Add(PackageNames[ PackageIndex ], MoveTemp(DependenciesPerPackage[ PackageIndex ]));
+	}
+	return true;
+}
+void FAssetReferenceIndex::Reset()
+{
+	PackageDependencies.Reset();
+	ReferencerCounts.Reset();
+}
+void FAssetReferenceIndex::AddOrUpdatePackage(const FName PackageName, TSet<FName>& OutTouchedPackages)
+{
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TArray<FName>& Dependencies = PackageDependencies.FindOrAdd(PackageName);
+
+	RemoveReferences(Dependencies);
+	OutTouchedPackages.Append(Dependencies);
+
+	QueryDependencies(AssetRegistryModule.Get(), PackageName, Dependencies);
+
+	AddReferences(Dependencies);
+	OutTouchedPackages.Append(Dependencies);
+	OutTouchedPackages.Add(PackageName);
+}
+void FAssetReferenceIndex::RemovePackage(const FName PackageName, TSet<FName>& OutTouchedPackages)
+{
+	TArray<FName> Dependencies;
+	if (!PackageDependencies.RemoveAndCopyValue(PackageName, Dependencies))
+	{
+		return;
+	}
+
+	RemoveReferences(Dependencies);
+	OutTouchedPackages.Append(Dependencies);
+	OutTouchedPackages.Add(PackageName);
+}
+bool FAssetReferenceIndex::ContainsPackage(const FName PackageName) const
+{
+	return PackageDependencies.Contains(PackageName);
+}
+bool FAssetReferenceIndex::IsPackageReferenced(const FName PackageName) const
+{
+	return ReferencerCounts.Contains(PackageName);
+}
+int32 FAssetReferenceIndex::GetReferencerCount(const FName PackageName) const
+{
+	const int32* Count = ReferencerCounts.Find(PackageName);
+	return Count ? *Count : 0;
+}
+void FAssetReferenceIndex::FilterUnreferencedAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnreferencedAssets) const
+{
+	for (const FAssetData& AssetData : AssetsToFilter)
+	{
+		if (!IsPackageReferenced(AssetData.PackageName))
+		{
+			OutUnreferencedAssets.Add(AssetData);
+		}
+	}
+}
+void FAssetReferenceIndex::FilterUnreferencedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnreferencedAssets) const
+{
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsToFilter)
+	{
+		if (AssetData.IsValid() && !IsPackageReferenced(AssetData->PackageName))
+		{
+			OutUnreferencedAssets.Add(AssetData);
+		}
+	}
+}
+void FAssetReferenceIndex::QueryDependencies(const IAssetRegistry& AssetRegistry, const FName PackageName, TArray<FName>& OutDependencies)
+{
+	// Same query UEditorAssetLibrary::FindPackageReferencersForAsset runs, from the other side
+	OutDependencies.Reset();
+	AssetRegistry.GetDependencies(PackageName, OutDependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::NoRequirements);
+	OutDependencies.Remove(PackageName);
+}
+void FAssetReferenceIndex::AddReferences(const TArray<FName>& Dependencies)
+{
+	for (const FName& Dependency : Dependencies)
+	{
+		++ReferencerCounts.FindOrAdd(Dependency);
+	}
+}
+void FAssetReferenceIndex::RemoveReferences(const TArray<FName>& Dependencies)
+{
+	for (const FName& Dependency : Dependencies)
+	{
+		int32* Count = ReferencerCounts.Find(Dependency);
+		if (Count && --(*Count) <= 0)
+		{
+			ReferencerCounts.Remove(Dependency);
+		}
+	}
+}
@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetScanCache.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace AssetScanCache
+{
+	constexpr uint32 FileMagic = 0x43535845; // "EXSC"
+	constexpr uint32 FileVersion = 5;
+
+	// Header: magic, version, entry count. Entry: UTF-8 name length and bytes, then the fixed size record.
+	constexpr int64 HeaderSize = sizeof(uint32) * 2 + sizeof(int32);
+	constexpr int64 RecordSize = sizeof(int64) * 2 + sizeof(uint32) + sizeof(uint64) * 2 + sizeof(int64) + sizeof(uint64);
+
+	template <typename T>
+	T ReadValue(const uint8*& Cursor)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Cursor, sizeof(T));
+		Cursor += sizeof(T);
+		return Value;
+	}
+
+	template <typename T>
+	void WriteValue(TArray<uint8>& Buffer, const T Value)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+}
+
+FString FAssetScanCache::GetCacheFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("EditorExtensions") / TEXT("AssetScanCache.bin");
+}
+bool FAssetScanCache::Load()
+{
+	using namespace AssetScanCache;
+
+	Entries.Reset();
+	bDirty = false;
+
+	const FString Filename = GetCacheFilename();
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+	if (!MappedFile || MappedFile->GetFileSize() < HeaderSize)
+	{
+		return false;
+	}
+
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	if (!MappedRegion)
+	{
+		return false;
+	}
+
+	const uint8* Cursor = MappedRegion->GetMappedPtr();
+	const uint8* const End = Cursor + MappedRegion->GetMappedSize();
+
+	const uint32 Magic = ReadValue<uint32>(Cursor);
+	const uint32 Version = ReadValue<uint32>(Cursor);
+	const int32 NumEntries = ReadValue<int32>(Cursor);
+
+	// Anything written by another version is recomputed rather than migrated
+	if (Magic != FileMagic || Version != FileVersion || NumEntries < 0)
+	{
+		return false;
+	}
+
+	Entries.Reserve(NumEntries);
+	for (int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex)
+	{
+		if (End - Cursor < static_cast<int64>(sizeof(uint16)))
+		{
+			break;
+		}
+		const uint16 NameLength = ReadValue<uint16>(Cursor);
+		if (End - Cursor < NameLength + RecordSize)
+		{
+			break;
+		}
+
+		const FUTF8ToTCHAR PackageName(reinterpret_cast<const ANSICHAR*>(Cursor), NameLength);
+		Cursor += NameLength;
+
+		FAssetScanCacheEntry Entry;
+		Entry.FileSize = ReadValue<int64>(Cursor);
+		Entry.ModifiedTicks = ReadValue<int64>(Cursor);
+		Entry.ValidFields = static_cast<EAssetScanCacheField>(ReadValue<uint32>(Cursor));
+		Entry.ContentHash = ReadValue<uint64>(Cursor);
+		Entry.PerceptualHash = ReadValue<uint64>(Cursor);
+		Entry.TextureMemorySize = ReadValue<int64>(Cursor);
+		Entry.GeometryHash = ReadValue<uint64>(Cursor);
+
+		Entries.Add(FName(PackageName.Length(), PackageName.Get()), Entry);
+	}
+	return true;
+}
+bool FAssetScanCache::Save()
+{
+	using namespace AssetScanCache;
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(HeaderSize + Entries.Num() * (RecordSize + 64));
+
+	WriteValue<uint32>(Buffer, FileMagic);
+	WriteValue<uint32>(Buffer, FileVersion);
+	WriteValue<int32>(Buffer, Entries.Num());
+
+	for (const TPair<FName, FAssetScanCacheEntry>& Pair : Entries)
+	{
+		const FTCHARToUTF8 PackageName(*Pair.Key.ToString());
+		const uint16 NameLength = static_cast<uint16>(FMath::Min(PackageName.Length(), static_cast<int32>(MAX_uint16)));
+
+		WriteValue<uint16>(Buffer, NameLength);
+		Buffer.Append(reinterpret_cast<const uint8*>(PackageName.Get()), NameLength);
+
+		const FAssetScanCacheEntry& Entry = Pair.Value;
+		WriteValue<int64>(Buffer, Entry.FileSize);
+		WriteValue<int64>(Buffer, Entry.ModifiedTicks);
+		WriteValue<uint32>(Buffer, static_cast<uint32>(Entry.ValidFields));
+		WriteValue<uint64>(Buffer, Entry.ContentHash);
+		WriteValue<uint64>(Buffer, Entry.PerceptualHash);
+		WriteValue<int64>(Buffer, Entry.TextureMemorySize);
+		WriteValue<uint64>(Buffer, Entry.GeometryHash);
+	}
+
+	// Written next to the cache and moved over it, so an interrupted save never leaves a torn file behind
+	const FString Filename = GetCacheFilename();
+	const FString TempFilename = Filename + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		return false;
+	}
+
+	bDirty = false;
+	return true;
+}
+const FAssetScanCacheEntry* FAssetScanCache::FindValid(const FName PackageName, const FFileStatData& StatData) const
+{
+	const FAssetScanCacheEntry* Entry = Entries.Find(PackageName);
+	return Entry && Entry->MatchesFile(StatData) ? Entry : nullptr;
+}
+void FAssetScanCache::Store(const FName PackageName, const FAssetScanCacheEntry& Entry)
+{
+	FAssetScanCacheEntry& StoredEntry = Entries.FindOrAdd(PackageName);
+
+	// Fields computed for an older version of the file no longer apply
+	if (!StoredEntry.MatchesFile(Entry.FileSize, Entry.ModifiedTicks))
+	{
+		StoredEntry = FAssetScanCacheEntry();
+		StoredEntry.FileSize = Entry.FileSize;
+		StoredEntry.ModifiedTicks = Entry.ModifiedTicks;
+	}
+
+	if (EnumHasAnyFlags(Entry.ValidFields, EAssetScanCacheField::ContentHash))
+	{
+		StoredEntry.ContentHash = Entry.ContentHash;
+	}
+	if (EnumHasAnyFlags(Entry.ValidFields, EAssetScanCacheField::PerceptualHash))
+	{
+		StoredEntry.PerceptualHash = Entry.PerceptualHash;
+		StoredEntry.TextureMemorySize = Entry.TextureMemorySize;
+	}
+	if (EnumHasAnyFlags(Entry.ValidFields, EAssetScanCacheField::GeometryHash))
+	{
+		StoredEntry.GeometryHash = Entry.GeometryHash;
+	}
+	StoredEntry.ValidFields |= Entry.ValidFields;
+	bDirty = true;
+}
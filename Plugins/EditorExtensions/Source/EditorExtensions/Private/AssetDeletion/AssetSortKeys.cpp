@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetSortKeys.h"
+
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+
+namespace AssetSortKeys
+{
+	template <typename GetFieldFunc>
+	void RankByField(const TArray<TSharedPtr<FAssetData>>& Assets, TArray<int32>& OutRanks, GetFieldFunc GetField)
+	{
+		TMap<FName, int32> RankByValue;
+		for (const TSharedPtr<FAssetData>& Data : Assets)
+		{
+			RankByValue.Add(Data.IsValid() ? GetField(*Data) : NAME_None, 0);
+		}
+
+		TArray<FName> SortedValues;
+		RankByValue.GenerateKeyArray(SortedValues);
+		SortedValues.Sort([](const FName& A, const FName& B)
+		{
+			return A.Compare(B) < 0;
+		});
+		for (int32 Rank = 0; Rank < SortedValues.Num(); ++Rank)
+		{
+			RankByValue[ SortedValues[ Rank ] ] = Rank;
+		}
+
+		OutRanks.SetNumUninitialized(Assets.Num());
+		for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+		{
+			OutRanks[ AssetIndex ] = RankByValue[ Assets[ AssetIndex ].IsValid() ? GetField(*Assets[ AssetIndex ]) : NAME_None ];
+		}
+	}
+
+	template <typename KeyType>
+	void CompactSlots(TArray<KeyType>& Keys, const TBitArray<>& RemovedSlots)
+	{
+		int32 NumKept = 0;
+		for (int32 Slot = 0; Slot < Keys.Num(); ++Slot)
+		{
+			if (!RemovedSlots[ Slot ])
+			{
+				Keys[ NumKept++ ] = Keys[ Slot ];
+			}
+		}
+		Keys.SetNum(NumKept);
+	}
+}
+
+void FAssetSortKeys::Build(const TArray<TSharedPtr<FAssetData>>& Assets)
+{
+	using namespace AssetSortKeys;
+
+	RankByField(Assets, NameRanks, [](const FAssetData& Data) { return Data.AssetName; });
+	RankByField(Assets, ClassRanks, [](const FAssetData& Data) { return Data.AssetClassPath.GetAssetName(); });
+	RankByField(Assets, PathRanks, [](const FAssetData& Data) { return Data.PackagePath; });
+
+	const int32 NumAssets = Assets.Num();
+	ReferencerCounts.SetNumZeroed(NumAssets);
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	const int32 NumChunks = FMath::Clamp(GetDefault<UAssetDeletionSettings>()->GetScanWorkerCount(), 1, FMath::Max(NumAssets, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumAssets, NumChunks);
+
+	ParallelFor(
+		NumChunks,
+		[&](const int32 ChunkIndex)
+		{
+			const int32 FirstAsset = ChunkIndex * ChunkSize;
+			const int32 LastAsset = FMath::Min(FirstAsset + ChunkSize, NumAssets);
+
+			TArray<FName> Referencers;
+			for (int32 AssetIndex = FirstAsset; AssetIndex < LastAsset; ++AssetIndex)
+			{
+				if (!Assets[ AssetIndex ].IsValid())
+				{
+					continue;
+				}
+
+				Referencers.Reset();
+				AssetRegistry.GetReferencers(Assets[ AssetIndex ]->PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package);
+				ReferencerCounts[ AssetIndex ] = Referencers.Num();
+			}
+		},
+		NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+}
+void FAssetSortKeys::RemoveSlots(const TBitArray<>& RemovedSlots)
+{
+	using namespace AssetSortKeys;
+
+	CompactSlots(NameRanks, RemovedSlots);
+	CompactSlots(ClassRanks, RemovedSlots);
+	CompactSlots(PathRanks, RemovedSlots);
+	CompactSlots(ReferencerCounts, RemovedSlots);
+}
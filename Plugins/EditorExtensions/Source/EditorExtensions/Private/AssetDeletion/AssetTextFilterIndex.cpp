@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/AssetTextFilterIndex.h"
+
+#include "Algo/AllOf.h"
+#include <atomic>
+
+namespace AssetTextFilterIndex
+{
+	// Longer tag values are serialized data rather than something to search for
+	constexpr int32 MaxTagValueLength = 256;
+
+	std::atomic<uint32> NextBuildId { 1 };
+
+	template <typename TokenFuncType>
+	void ForEachToken(const FAssetData& Data, TokenFuncType&& TokenFunc)
+	{
+		TokenFunc(Data.AssetName.ToString());
+		TokenFunc(Data.PackagePath.ToString());
+		TokenFunc(Data.AssetClassPath.GetAssetName().ToString());
+
+		for (const TPair<FName, FAssetTagValueRef>& Tag : Data.TagsAndValues)
+		{
+			FString TagValue = Tag.Value.AsString();
+			if (TagValue.Len() <= MaxTagValueLength)
+			{
+				TokenFunc(MoveTemp(TagValue));
+			}
+		}
+	}
+}
+
+void FAssetTextFilterIndex::Build(const TArray<TSharedPtr<FAssetData>>& InAssets)
+{
+	BuildId = AssetTextFilterIndex::NextBuildId.fetch_add(1, std::memory_order_relaxed);
+	Assets = InAssets;
+	Tokens.Reset();
+	EntriesByToken.Reset();
+
+	TMap<FString, int32> TokenIndices;
+	auto AddToken = [this, &TokenIndices](FString&& Token, const int32 EntryIndex)
+	{
+		if (Token.IsEmpty())
+		{
+			return;
+		}
+		Token.ToLowerInline();
+
+		int32& TokenIndex = TokenIndices.FindOrAdd(Token, INDEX_NONE);
+		if (TokenIndex == INDEX_NONE)
+		{
+			TokenIndex = Tokens.Add(MoveTemp(Token));
+			EntriesByToken.AddDefaulted();
+		}
+
+		// Entries are added in order, so checking the last one is enough to stay sorted and unique
+		TArray<int32>& TokenEntries = EntriesByToken[ TokenIndex ];
+		if (TokenEntries.IsEmpty() || TokenEntries.Last() != EntryIndex)
+		{
+			TokenEntries.Add(EntryIndex);
+		}
+	};
+
+	for (int32 EntryIndex = 0; EntryIndex < Assets.Num(); ++EntryIndex)
+	{
+		const TSharedPtr<FAssetData>& Data = Assets[ EntryIndex ];
+		if (!Data.IsValid())
+		{
+			continue;
+		}
+
+		AssetTextFilterIndex::ForEachToken(*Data, [&AddToken, EntryIndex](FString&& Token)
+		{
+			AddToken(MoveTemp(Token), EntryIndex);
+		});
+	}
+}
+void FAssetTextFilterIndex::Query(const FString& QueryText, FAssetTextFilterResult& OutResult, const FAssetTextFilterResult* PreviousResult) const
+{
+	OutResult = FAssetTextFilterResult();
+	OutResult.IndexBuildId = BuildId;
+	QueryText.ToLower().ParseIntoArrayWS(OutResult.Terms);
+	OutResult.MatchedTokensPerTerm.SetNum(OutResult.Terms.Num());
+
+	TBitArray<> MatchedEntryBits;
+	for (int32 TermIndex = 0; TermIndex < OutResult.Terms.Num(); ++TermIndex)
+	{
+		const FString& Term = OutResult.Terms[ TermIndex ];
+		TArray<int32>& MatchedTokens = OutResult.MatchedTokensPerTerm[ TermIndex ];
+
+		const bool bCanNarrow = PreviousResult && PreviousResult->IndexBuildId == BuildId && PreviousResult->Terms.IsValidIndex(TermIndex) && Term.Contains(PreviousResult->Terms[ TermIndex ], ESearchCase::CaseSensitive);
+		if (bCanNarrow)
+		{
+			for (const int32 TokenIndex : PreviousResult->MatchedTokensPerTerm[ TermIndex ])
+			{
+				if (Tokens[ TokenIndex ].Contains(Term, ESearchCase::CaseSensitive))
+				{
+					MatchedTokens.Add(TokenIndex);
+				}
+			}
+		}
+		else
+		{
+			for (int32 TokenIndex = 0; TokenIndex < Tokens.Num(); ++TokenIndex)
+			{
+				if (Tokens[ TokenIndex ].Contains(Term, ESearchCase::CaseSensitive))
+				{
+					MatchedTokens.Add(TokenIndex);
+				}
+			}
+		}
+
+		TBitArray<> TermEntryBits(false, Assets.Num());
+		for (const int32 TokenIndex : MatchedTokens)
+		{
+			for (const int32 EntryIndex : EntriesByToken[ TokenIndex ])
+			{
+				TermEntryBits[ EntryIndex ] = true;
+			}
+		}
+
+		if (TermIndex == 0)
+		{
+			MatchedEntryBits = MoveTemp(TermEntryBits);
+		}
+		else
+		{
+			MatchedEntryBits.CombineWithBitwiseAND(TermEntryBits, EBitwiseOperatorFlags::MaintainSize);
+		}
+	}
+
+	for (TConstSetBitIterator<> It(MatchedEntryBits); It; ++It)
+	{
+		OutResult.MatchedEntries.Add(It.GetIndex());
+	}
+}
+bool FAssetTextFilterIndex::MatchesTerms(const FAssetData& AssetData, const TArray<FString>& Terms)
+{
+	TArray<FString> AssetTokens;
+	AssetTextFilterIndex::ForEachToken(AssetData, [&AssetTokens](FString&& Token)
+	{
+		Token.ToLowerInline();
+		AssetTokens.Add(MoveTemp(Token));
+	});
+
+	return Algo::AllOf(Terms, [&AssetTokens](const FString& Term)
+	{
+		return AssetTokens.ContainsByPredicate([&Term](const FString& Token)
+		{
+			return Token.Contains(Term, ESearchCase::CaseSensitive);
+		});
+	});
+}
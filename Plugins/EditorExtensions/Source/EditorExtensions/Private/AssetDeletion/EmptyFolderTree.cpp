@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/EmptyFolderTree.h"
+
+#include "AssetActions/AssetFolderEnumerator.h"
+#include "AssetDeletion/AssetExclusionMatcher.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+bool FEmptyFolderTree::Build(const FString& RootPath, const FAssetExclusionMatcher& ExclusionMatcher, FAssetScanProgress& Progress)
+{
+	Nodes.Reset();
+	EmptySubtreeRoots.Reset();
+	NumEmptyFolders = 0;
+	NumExcludedFolders = 0;
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	FString NormalizedRootPath = RootPath;
+	NormalizedRootPath.RemoveFromEnd(TEXT("/"));
+
+	TArray<FString> SubFolderPaths;
+	AssetRegistryModule.Get().GetSubPaths(NormalizedRootPath, SubFolderPaths, true);
+	Progress.AddTotal(SubFolderPaths.Num());
+
+	// The root is node 0 and is never reported, the selected folder itself stays
+	TMap<FString, int32> NodeIndexByPath;
+	NodeIndexByPath.Reserve(SubFolderPaths.Num() + 1);
+	Nodes.Reserve(SubFolderPaths.Num() + 1);
+
+	Nodes.Add({ NormalizedRootPath });
+	NodeIndexByPath.Add(NormalizedRootPath, 0);
+	for (FString& SubFolderPath : SubFolderPaths)
+	{
+		NodeIndexByPath.Add(SubFolderPath, Nodes.Num());
+		Nodes.Add({ MoveTemp(SubFolderPath) });
+	}
+
+	for (int32 NodeIndex = 1; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		FFolderNode& Node = Nodes[ NodeIndex ];
+		Node.ParentIndex = 0;
+
+		int32 LastSlashIndex = INDEX_NONE;
+		if (Node.Path.FindLastChar(TEXT('/'), LastSlashIndex))
+		{
+			if (const int32* ParentIndex = NodeIndexByPath.Find(Node.Path.Left(LastSlashIndex)))
+			{
+				Node.ParentIndex = *ParentIndex;
+			}
+		}
+
+		if (ExclusionMatcher.IsFolderExcluded(Node.Path))
+		{
+			Node.bHasContent = true;
+			++NumExcludedFolders;
+		}
+	}
+
+	TArray<FAssetData> AssetsUnderRoot;
+	FAssetFolderEnumerator::GetAssetsUnderFolder(NormalizedRootPath, AssetsUnderRoot);
+	for (const FAssetData& AssetData : AssetsUnderRoot)
+	{
+		if (const int32* NodeIndex = NodeIndexByPath.Find(AssetData.PackagePath.ToString()))
+		{
+			Nodes[ *NodeIndex ].bHasContent = true;
+		}
+	}
+
+	// A child path is always longer than its parent's, so longest first visits every child before its parent
+	TArray<int32> PostOrder;
+	PostOrder.Reserve(Nodes.Num() - 1);
+	for (int32 NodeIndex = 1; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		PostOrder.Add(NodeIndex);
+	}
+	PostOrder.Sort([this](const int32 A, const int32 B)
+	{
+		return Nodes[ A ].Path.Len() > Nodes[ B ].Path.Len();
+	});
+
+	for (const int32 NodeIndex : PostOrder)
+	{
+		if (Progress.IsCancelRequested())
+		{
+			return false;
+		}
+		Progress.Advance();
+
+		const FFolderNode& Node = Nodes[ NodeIndex ];
+		if (Node.bHasContent)
+		{
+			Nodes[ Node.ParentIndex ].bHasContent = true;
+		}
+		else
+		{
+			++NumEmptyFolders;
+		}
+	}
+
+	for (int32 NodeIndex = 1; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const FFolderNode& Node = Nodes[ NodeIndex ];
+		if (!Node.bHasContent && (Node.ParentIndex == 0 || Nodes[ Node.ParentIndex ].bHasContent))
+		{
+			EmptySubtreeRoots.Add(Node.Path);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/StaticMeshSignature.h"
+
+#include "Algo/BinarySearch.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+
+namespace StaticMeshSignature
+{
+	constexpr float PositionGridScale = 100.f;
+	constexpr float UVGridScale = 4096.f;
+
+	// Written by UStaticMesh::GetAssetRegistryTags
+	const FName GeometryTagNames[] = { TEXT("Vertices"), TEXT("Triangles"), TEXT("LODs"), TEXT("Materials"), TEXT("ApproxSize") };
+}
+
+bool FStaticMeshSignature::GetTagKey(const FAssetData& AssetData, uint64& OutKey)
+{
+	FXxHash64Builder KeyBuilder;
+	for (const FName& TagName : StaticMeshSignature::GeometryTagNames)
+	{
+		FString TagValue;
+		if (!AssetData.GetTagValue(TagName, TagValue))
+		{
+			return false;
+		}
+
+		// Separator keeps "12"+"3" apart from "1"+"23"
+		TagValue.AppendChar(TEXT('|'));
+		KeyBuilder.Update(*TagValue, TagValue.Len() * sizeof(TCHAR));
+	}
+
+	OutKey = KeyBuilder.Finalize().Hash;
+	return true;
+}
+uint64 FStaticMeshSignature::CombineKeys(const uint64 TagKey, const uint64 GeometryHash)
+{
+	const uint64 Keys[ 2 ] = { TagKey, GeometryHash };
+	return FXxHash64::HashBuffer(Keys, sizeof(Keys)).Hash;
+}
+bool FStaticMeshSignature::ExtractGeometry(const FMeshDescription& MeshDescription, FGeometry& OutGeometry)
+{
+	using namespace StaticMeshSignature;
+
+	const FStaticMeshConstAttributes Attributes(MeshDescription);
+	const TVertexAttributesConstRef<FVector3f> VertexPositions = Attributes.GetVertexPositions();
+	const TVertexInstanceAttributesConstRef<FVector2f> VertexInstanceUVs = Attributes.GetVertexInstanceUVs();
+	const TPolygonGroupAttributesConstRef<FName> MaterialSlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+	if (!VertexPositions.IsValid())
+	{
+		return false;
+	}
+	const bool bHasUVs = VertexInstanceUVs.IsValid() && VertexInstanceUVs.GetNumChannels() > 0;
+
+	// Vertex IDs can be sparse, the copy numbers vertices densely
+	TArray<int32> VertexIndexByID;
+	VertexIndexByID.Init(INDEX_NONE, MeshDescription.Vertices().GetArraySize());
+	OutGeometry.GridPositions.Reset(MeshDescription.Vertices().Num());
+	for (const FVertexID VertexID : MeshDescription.Vertices().GetElementIDs())
+	{
+		const FVector3f& Position = VertexPositions[ VertexID ];
+		VertexIndexByID[ VertexID.GetValue() ] = OutGeometry.GridPositions.Add(FIntVector(
+			FMath::RoundToInt(Position.X * PositionGridScale),
+			FMath::RoundToInt(Position.Y * PositionGridScale),
+			FMath::RoundToInt(Position.Z * PositionGridScale)));
+	}
+
+	TMap<FPolygonGroupID, int32> SlotIndexByGroup;
+	OutGeometry.MaterialSlotNames.Reset();
+	for (const FPolygonGroupID PolygonGroupID : MeshDescription.PolygonGroups().GetElementIDs())
+	{
+		const FString SlotName = MaterialSlotNames.IsValid() ? MaterialSlotNames[ PolygonGroupID ].ToString() : FString();
+		SlotIndexByGroup.Add(PolygonGroupID, OutGeometry.MaterialSlotNames.Add(SlotName));
+	}
+
+	const int32 NumTriangles = MeshDescription.Triangles().Num();
+	OutGeometry.CornerVertices.Reset(NumTriangles * 3);
+	OutGeometry.CornerGridUVs.Reset(NumTriangles * 3);
+	OutGeometry.TriangleSlots.Reset(NumTriangles);
+	for (const FTriangleID TriangleID : MeshDescription.Triangles().GetElementIDs())
+	{
+		const TArrayView<const FVertexInstanceID> VertexInstances = MeshDescription.GetTriangleVertexInstances(TriangleID);
+		for (int32 CornerIndex = 0; CornerIndex < 3; ++CornerIndex)
+		{
+			const FVertexInstanceID VertexInstanceID = VertexInstances[ CornerIndex ];
+			const FVector2f UV = bHasUVs ? VertexInstanceUVs.Get(VertexInstanceID, 0) : FVector2f::ZeroVector;
+
+			OutGeometry.CornerVertices.Add(VertexIndexByID[ MeshDescription.GetVertexInstanceVertex(VertexInstanceID).GetValue() ]);
+			OutGeometry.CornerGridUVs.Add(FIntPoint(FMath::RoundToInt(UV.X * UVGridScale), FMath::RoundToInt(UV.Y * UVGridScale)));
+		}
+		OutGeometry.TriangleSlots.Add(SlotIndexByGroup.FindRef(MeshDescription.GetTrianglePolygonGroup(TriangleID)));
+	}
+	return true;
+}
+bool FStaticMeshSignature::HashGeometries(const TArray<TOptional<FGeometry>>& Geometries, TArray<TOptional<uint64>>& OutHashes, FAssetScanProgress* Progress)
+{
+	const int32 NumMeshes = Geometries.Num();
+	if (Progress)
+	{
+		Progress->SetTotal(NumMeshes);
+	}
+
+	OutHashes.Reset();
+	OutHashes.SetNum(NumMeshes);
+
+	const int32 NumChunks = FMath::Clamp(GetDefault<UAssetDeletionSettings>()->GetScanWorkerCount(), 1, FMath::Max(NumMeshes, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumMeshes, NumChunks);
+
+	ParallelFor(
+		NumChunks,
+		[&](const int32 ChunkIndex)
+		{
+			const int32 FirstMesh = ChunkIndex * ChunkSize;
+			const int32 LastMesh = FMath::Min(FirstMesh + ChunkSize, NumMeshes);
+
+			for (int32 MeshIndex = FirstMesh; MeshIndex < LastMesh; ++MeshIndex)
+			{
+				if (Progress)
+				{
+					if (Progress->IsCancelRequested())
+					{
+						return;
+					}
+					Progress->Advance();
+				}
+
+				if (Geometries[ MeshIndex ].IsSet())
+				{
+					OutHashes[ MeshIndex ] = HashGeometry(Geometries[ MeshIndex ].GetValue());
+				}
+			}
+		},
+		NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+	return !(Progress && Progress->IsCancelRequested());
+}
+uint64 FStaticMeshSignature::HashGeometry(const FGeometry& Geometry)
+{
+	// Each vertex keyed by its snapped position hash
+	const int32 NumVertices = Geometry.GridPositions.Num();
+	TArray<uint64> VertexHashes;
+	VertexHashes.SetNumUninitialized(NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+	{
+		const FIntVector& GridPosition = Geometry.GridPositions[ VertexIndex ];
+		const int32 GridCoordinates[ 3 ] = { GridPosition.X, GridPosition.Y, GridPosition.Z };
+		VertexHashes[ VertexIndex ] = FXxHash64::HashBuffer(GridCoordinates, sizeof(GridCoordinates)).Hash;
+	}
+
+	// Sorted so a re-import that only reorders vertices still matches. Triangles refer to vertices by their rank in
+	// this order, vertices welded or split at the same position share a rank.
+	TArray<uint64> SortedVertexHashes = VertexHashes;
+	SortedVertexHashes.Sort();
+	TArray<int32> VertexRanks;
+	VertexRanks.SetNumUninitialized(NumVertices);
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+	{
+		VertexRanks[ VertexIndex ] = Algo::LowerBound(SortedVertexHashes, VertexHashes[ VertexIndex ]);
+	}
+
+	struct FCorner
+	{
+		int32 VertexRank;
+		int32 GridUV[ 2 ];
+	};
+
+	const int32 NumTriangles = Geometry.TriangleSlots.Num();
+	TArray<uint64> TriangleHashes;
+	TriangleHashes.Reserve(NumTriangles);
+	for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; ++TriangleIndex)
+	{
+		FCorner Corners[ 3 ];
+		for (int32 CornerIndex = 0; CornerIndex < 3; ++CornerIndex)
+		{
+			const int32 GeometryCorner = TriangleIndex * 3 + CornerIndex;
+			FCorner& Corner = Corners[ CornerIndex ];
+			Corner.VertexRank = VertexRanks[ Geometry.CornerVertices[ GeometryCorner ] ];
+			Corner.GridUV[ 0 ] = Geometry.CornerGridUVs[ GeometryCorner ].X;
+			Corner.GridUV[ 1 ] = Geometry.CornerGridUVs[ GeometryCorner ].Y;
+		}
+
+		// Rotated to start at the lowest ranked corner, which keeps the winding but not the index buffer order
+		int32 FirstCorner = 0;
+		for (int32 CornerIndex = 1; CornerIndex < 3; ++CornerIndex)
+		{
+			if (Corners[ CornerIndex ].VertexRank < Corners[ FirstCorner ].VertexRank)
+			{
+				FirstCorner = CornerIndex;
+			}
+		}
+
+		// Slots are matched by name, their order in the mesh is not part of the geometry
+		const FString& MaterialSlotName = Geometry.MaterialSlotNames[ Geometry.TriangleSlots[ TriangleIndex ] ];
+
+		FXxHash64Builder TriangleBuilder;
+		for (int32 CornerOffset = 0; CornerOffset < 3; ++CornerOffset)
+		{
+			const FCorner& Corner = Corners[ (FirstCorner + CornerOffset) % 3 ];
+			TriangleBuilder.Update(&Corner.VertexRank, sizeof(Corner.VertexRank));
+			TriangleBuilder.Update(Corner.GridUV, sizeof(Corner.GridUV));
+		}
+		TriangleBuilder.Update(*MaterialSlotName, MaterialSlotName.Len() * sizeof(TCHAR));
+		TriangleHashes.Add(TriangleBuilder.Finalize().Hash);
+	}
+	TriangleHashes.Sort();
+
+	FXxHash64Builder GeometryBuilder;
+	GeometryBuilder.Update(SortedVertexHashes.GetData(), SortedVertexHashes.Num() * sizeof(uint64));
+	GeometryBuilder.Update(TriangleHashes.GetData(), TriangleHashes.Num() * sizeof(uint64));
+	return GeometryBuilder.Finalize().Hash;
+}
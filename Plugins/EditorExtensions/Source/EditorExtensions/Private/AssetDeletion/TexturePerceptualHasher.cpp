@@ -0,0 +1,229 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/TexturePerceptualHasher.h"
+
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture.h"
+#include "ImageCore.h"
+
+namespace TexturePerceptualHasher
+{
+	constexpr int32 GridWidth = 9;
+	constexpr int32 GridHeight = 8;
+	constexpr int32 MinSourceSize = 64;
+
+	// Pixels converted to float at once, a single mip source is never converted whole
+	constexpr int64 PixelsPerStrip = 256 * 1024;
+
+	// The smallest source mip that still covers the grid with several pixels per cell
+	int32 GetHashMipIndex(const FTextureSource& Source)
+	{
+		int32 MipIndex = 0;
+		while (MipIndex + 1 < Source.GetNumMips()
+			&& (Source.GetSizeX() >> (MipIndex + 1)) >= MinSourceSize
+			&& (Source.GetSizeY() >> (MipIndex + 1)) >= MinSourceSize)
+		{
+			++MipIndex;
+		}
+		return MipIndex;
+	}
+
+	// Decoded source images held by the workers at once. The first one always fits, however large, so no worker waits forever.
+	class FDecodeBudget
+	{
+	public:
+		explicit FDecodeBudget(const int64 InBudget)
+			: Budget(InBudget)
+		{
+		}
+
+		bool Acquire(const int64 Bytes, const FAssetScanProgress* Progress)
+		{
+			for (;;)
+			{
+				{
+					FScopeLock Lock(&CriticalSection);
+					if (BytesInFlight == 0 || BytesInFlight + Bytes <= Budget)
+					{
+						BytesInFlight += Bytes;
+						return true;
+					}
+				}
+
+				if (Progress && Progress->IsCancelRequested())
+				{
+					return false;
+				}
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+
+		void Release(const int64 Bytes)
+		{
+			FScopeLock Lock(&CriticalSection);
+			BytesInFlight -= Bytes;
+		}
+
+	private:
+		FCriticalSection CriticalSection;
+		const int64 Budget;
+		int64 BytesInFlight = 0;
+	};
+}
+
+bool FTexturePerceptualHasher::HashTextures(TArray<FTextureSource>& Sources, TArray<TOptional<uint64>>& OutHashes, FAssetScanProgress* Progress)
+{
+	const int32 NumTextures = Sources.Num();
+	if (Progress)
+	{
+		Progress->SetTotal(NumTextures);
+	}
+
+	OutHashes.Reset();
+	OutHashes.SetNum(NumTextures);
+
+	const UAssetDeletionSettings* Settings = GetDefault<UAssetDeletionSettings>();
+	TexturePerceptualHasher::FDecodeBudget DecodeBudget(Settings->TextureHashMemoryBudgetMB > 0 ? int64(Settings->TextureHashMemoryBudgetMB) * 1024 * 1024 : MAX_int64);
+
+	const int32 NumChunks = FMath::Clamp(Settings->GetScanWorkerCount(), 1, FMath::Max(NumTextures, 1));
+	const int32 ChunkSize = FMath::DivideAndRoundUp(NumTextures, NumChunks);
+
+	ParallelFor(
+		NumChunks,
+		[&](const int32 ChunkIndex)
+		{
+			const int32 FirstTexture = ChunkIndex * ChunkSize;
+			const int32 LastTexture = FMath::Min(FirstTexture + ChunkSize, NumTextures);
+
+			for (int32 TextureIndex = FirstTexture; TextureIndex < LastTexture; ++TextureIndex)
+			{
+				if (Progress)
+				{
+					if (Progress->IsCancelRequested())
+					{
+						return;
+					}
+					Progress->Advance();
+				}
+
+				FTextureSource& Source = Sources[ TextureIndex ];
+				if (!Source.IsValid())
+				{
+					continue;
+				}
+
+				const int64 DecodedBytes = Source.CalcMipSize(0, 0, TexturePerceptualHasher::GetHashMipIndex(Source));
+				if (!DecodeBudget.Acquire(DecodedBytes, Progress))
+				{
+					return;
+				}
+
+				uint64 Hash = 0;
+				if (HashTextureSource(Source, Hash))
+				{
+					OutHashes[ TextureIndex ] = Hash;
+				}
+				DecodeBudget.Release(DecodedBytes);
+			}
+		},
+		NumChunks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+	return !(Progress && Progress->IsCancelRequested());
+}
+bool FTexturePerceptualHasher::HashTextureSource(FTextureSource& Source, uint64& OutHash)
+{
+	using namespace TexturePerceptualHasher;
+
+	if (!Source.IsValid())
+	{
+		return false;
+	}
+
+	FImage SourceImage;
+	if (!Source.GetMipImage(SourceImage, 0, 0, GetHashMipIndex(Source)))
+	{
+		return false;
+	}
+
+	const int32 SizeX = SourceImage.SizeX;
+	const int32 SizeY = SourceImage.SizeY;
+	if (SizeX < GridWidth || SizeY < GridHeight)
+	{
+		return false;
+	}
+
+	// Pixels are summed straight into their grid cell, a box filter with no per pixel division
+	TArray<int32, TInlineAllocator<MinSourceSize>> CellColumnOfPixel;
+	CellColumnOfPixel.SetNumUninitialized(SizeX);
+	int32 PixelsPerColumn[ GridWidth ] = {};
+	for (int32 X = 0; X < SizeX; ++X)
+	{
+		CellColumnOfPixel[ X ] = X * GridWidth / SizeX;
+		++PixelsPerColumn[ CellColumnOfPixel[ X ] ];
+	}
+
+	int32 PixelsPerRow[ GridHeight ] = {};
+	VectorRegister4Float CellSums[ GridWidth * GridHeight ];
+	for (VectorRegister4Float& CellSum : CellSums)
+	{
+		CellSum = VectorZeroFloat();
+	}
+
+	// Every source format becomes four floats per pixel, one vector register, a strip of rows at a time
+	const int64 BytesPerRow = int64(SizeX) * SourceImage.GetBytesPerPixel();
+	const int32 RowsPerStrip = int32(FMath::Clamp<int64>(PixelsPerStrip / SizeX, 1, SizeY));
+
+	FImage LinearStrip;
+	for (int32 FirstRow = 0; FirstRow < SizeY; FirstRow += RowsPerStrip)
+	{
+		const int32 NumStripRows = FMath::Min(RowsPerStrip, SizeY - FirstRow);
+		const FImageView SourceStrip(SourceImage.RawData.GetData() + FirstRow * BytesPerRow, SizeX, NumStripRows, 1, SourceImage.Format, SourceImage.GammaSpace);
+		LinearStrip.Init(SizeX, NumStripRows, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		FImageCore::CopyImage(SourceStrip, LinearStrip);
+
+		const TArrayView64<FLinearColor> Pixels = LinearStrip.AsRGBA32F();
+		for (int32 StripRow = 0; StripRow < NumStripRows; ++StripRow)
+		{
+			const int32 CellRow = (FirstRow + StripRow) * GridHeight / SizeY;
+			++PixelsPerRow[ CellRow ];
+
+			VectorRegister4Float* RowCells = CellSums + CellRow * GridWidth;
+			const FLinearColor* RowPixels = Pixels.GetData() + int64(StripRow) * SizeX;
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				VectorRegister4Float& CellSum = RowCells[ CellColumnOfPixel[ X ] ];
+				CellSum = VectorAdd(CellSum, VectorLoad(&RowPixels[ X ].R));
+			}
+		}
+	}
+
+	// Rec. 709 luminance of the averaged linear color, alpha ignored
+	const VectorRegister4Float LumaWeights = MakeVectorRegister(0.2126f, 0.7152f, 0.0722f, 0.f);
+
+	float CellLuma[ GridWidth * GridHeight ];
+	for (int32 CellY = 0; CellY < GridHeight; ++CellY)
+	{
+		for (int32 CellX = 0; CellX < GridWidth; ++CellX)
+		{
+			const int32 CellIndex = CellY * GridWidth + CellX;
+			const float NumCellPixels = float(PixelsPerColumn[ CellX ] * PixelsPerRow[ CellY ]);
+			CellLuma[ CellIndex ] = VectorGetComponent(VectorDot3(CellSums[ CellIndex ], LumaWeights), 0) / NumCellPixels;
+		}
+	}
+
+	OutHash = 0;
+	for (int32 CellY = 0; CellY < GridHeight; ++CellY)
+	{
+		for (int32 CellX = 0; CellX + 1 < GridWidth; ++CellX)
+		{
+			const int32 CellIndex = CellY * GridWidth + CellX;
+			if (CellLuma[ CellIndex ] < CellLuma[ CellIndex + 1 ])
+			{
+				OutHash |= uint64(1) << (CellY * (GridWidth - 1) + CellX);
+			}
+		}
+	}
+	return true;
+}
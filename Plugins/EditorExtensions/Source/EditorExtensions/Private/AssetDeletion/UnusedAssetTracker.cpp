@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetDeletion/UnusedAssetTracker.h"
+
+#include "AssetActions/AssetFolderEnumerator.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FUnusedAssetTracker::Initialize()
+{
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnusedAssetTracker::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnusedAssetTracker::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnusedAssetTracker::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FUnusedAssetTracker::OnAssetUpdated);
+}
+void FUnusedAssetTracker::Shutdown()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	ReferenceIndex.Reset();
+	bIndexBuilt = false;
+	bRecordEvents = false;
+
+	PendingPackages.Reset();
+	UnusedPackagePaths.Reset();
+	UnusedPackagesByPath.Reset();
+}
+void FUnusedAssetTracker::GetUnusedAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutUnusedAssets)
+{
+	GetUnusedAssetsUnderFolders({ FolderPath }, OutUnusedAssets);
+}
+void FUnusedAssetTracker::GetUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutUnusedAssets)
+{
+	FlushPendingPackages();
+
+	TArray<FString> RootPaths;
+	for (FString RootPath : FolderPaths)
+	{
+		RootPath.RemoveFromEnd(TEXT("/"));
+		RootPaths.Add(MoveTemp(RootPath));
+	}
+
+	// Each bucket is taken at most once, so overlapping folders don't produce duplicates
+	TArray<FName> UnusedPackageNames;
+	for (const TPair<FName, TSet<FName>>& PathPackages : UnusedPackagesByPath)
+	{
+		const FString PackagePath = PathPackages.Key.ToString();
+		const bool bIsUnderRoot = RootPaths.ContainsByPredicate([&PackagePath](const FString& RootPath)
+		{
+			return PackagePath == RootPath || PackagePath.StartsWith(RootPath + TEXT("/"));
+		});
+
+		if (bIsUnderRoot)
+		{
+			UnusedPackageNames.Append(PathPackages.Value.Array());
+		}
+	}
+
+	FAssetFolderEnumerator::GetAssetsInPackages(UnusedPackageNames, OutUnusedAssets);
+}
+bool FUnusedAssetTracker::IsPackageUnused(const FName PackageName)
+{
+	FlushPendingPackages();
+	return UnusedPackagePaths.Contains(PackageName);
+}
+void FUnusedAssetTracker::FilterUnusedAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnusedAssets)
+{
+	FlushPendingPackages();
+
+	for (const FAssetData& AssetData : AssetsToFilter)
+	{
+		if (UnusedPackagePaths.Contains(AssetData.PackageName))
+		{
+			OutUnusedAssets.Add(AssetData);
+		}
+	}
+}
+void FUnusedAssetTracker::FilterUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssets)
+{
+	FlushPendingPackages();
+
+	for (const TSharedPtr<FAssetData>& AssetData : AssetsToFilter)
+	{
+		if (AssetData.IsValid() && UnusedPackagePaths.Contains(AssetData->PackageName))
+		{
+			OutUnusedAssets.Add(AssetData);
+		}
+	}
+}
+const FAssetReferenceIndex& FUnusedAssetTracker::GetReferenceIndex()
+{
+	FlushPendingPackages();
+	return ReferenceIndex;
+}
+void FUnusedAssetTracker::BeginExternalIndexBuild()
+{
+	bRecordEvents = true;
+}
+void FUnusedAssetTracker::AdoptIndex(FAssetReferenceIndex&& BuiltIndex)
+{
+	// A synchronous build got there first and has already applied newer events
+	if (bIndexBuilt)
+	{
+		return;
+	}
+
+	ReferenceIndex = MoveTemp(BuiltIndex);
+	bIndexBuilt = true;
+	bRecordEvents = true;
+
+	RebuildUnusedPackages();
+}
+void FUnusedAssetTracker::FlushPendingPackages()
+{
+	// First query pays for the full build, events before that have nothing to update
+	if (!bIndexBuilt)
+	{
+		ReferenceIndex.Build();
+		bIndexBuilt = true;
+		bRecordEvents = true;
+
+		PendingPackages.Reset();
+		RebuildUnusedPackages();
+		return;
+	}
+
+	if (PendingPackages.IsEmpty())
+	{
+		return;
+	}
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	TSet<FName> TouchedPackages;
+	TArray<FAssetData> PackageAssets;
+	for (const FName& PackageName : PendingPackages)
+	{
+		PackageAssets.Reset();
+		AssetRegistryModule.Get().GetAssetsByPackageName(PackageName, PackageAssets);
+
+		if (PackageAssets.IsEmpty())
+		{
+			ReferenceIndex.RemovePackage(PackageName, TouchedPackages);
+		}
+		else
+		{
+			ReferenceIndex.AddOrUpdatePackage(PackageName, TouchedPackages);
+		}
+	}
+	PendingPackages.Reset();
+
+	for (const FName& PackageName : TouchedPackages)
+	{
+		RefreshUnusedState(PackageName);
+	}
+}
+void FUnusedAssetTracker::RebuildUnusedPackages()
+{
+	UnusedPackagePaths.Reset();
+	UnusedPackagesByPath.Reset();
+
+	for (const TPair<FName, TArray<FName>>& PackageDependencies : ReferenceIndex.GetPackageDependencies())
+	{
+		RefreshUnusedState(PackageDependencies.Key);
+	}
+}
+void FUnusedAssetTracker::RefreshUnusedState(const FName PackageName)
+{
+	FName PreviousPackagePath;
+	if (UnusedPackagePaths.RemoveAndCopyValue(PackageName, PreviousPackagePath))
+	{
+		TSet<FName>& PathPackages = UnusedPackagesByPath.FindChecked(PreviousPackagePath);
+		PathPackages.Remove(PackageName);
+		if (PathPackages.IsEmpty())
+		{
+			UnusedPackagesByPath.Remove(PreviousPackagePath);
+		}
+	}
+
+	if (!ReferenceIndex.ContainsPackage(PackageName) || ReferenceIndex.IsPackageReferenced(PackageName))
+	{
+		return;
+	}
+
+	const FName PackagePath(FPackageName::GetLongPackagePath(PackageName.ToString()));
+	UnusedPackagePaths.Add(PackageName, PackagePath);
+	UnusedPackagesByPath.FindOrAdd(PackagePath).Add(PackageName);
+}
+void FUnusedAssetTracker::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (bRecordEvents)
+	{
+		PendingPackages.Add(AssetData.PackageName);
+	}
+}
+void FUnusedAssetTracker::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (bRecordEvents)
+	{
+		PendingPackages.Add(AssetData.PackageName);
+	}
+}
+void FUnusedAssetTracker::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (bRecordEvents)
+	{
+		PendingPackages.Add(AssetData.PackageName);
+		PendingPackages.Add(FName(FPackageName::ObjectPathToPackageName(OldObjectPath)));
+	}
+}
+void FUnusedAssetTracker::OnAssetUpdated(const FAssetData& AssetData)
+{
+	if (bRecordEvents)
+	{
+		PendingPackages.Add(AssetData.PackageName);
+	}
+}
@@ -6,6 +6,25 @@
 #include "EditorAssetLibrary.h"
 #include "ObjectTools.h"
 #include "AssetActions/AssetActionExtender.h"
+#include "AssetActions/AssetFolderEnumerator.h"
+#include "AssetActions/AssetFolderStream.h"
+#include "AssetActions/RedirectorFixupService.h"
+#include "AssetDeletion/AssetBatchDeletion.h"
+#include "AssetDeletion/AssetCleanupScan.h"
+#include "AssetDeletion/AssetContentHasher.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+#include "AssetDeletion/AssetDuplicateGrouper.h"
+#include "AssetDeletion/AssetReachabilityAnalyzer.h"
+#include "AssetDeletion/AssetScanCache.h"
+#include "AssetDeletion/EmptyFolderTree.h"
+#include "AssetDeletion/StaticMeshSignature.h"
+#include "AssetDeletion/TexturePerceptualHasher.h"
+#include "AssetDeletion/UnusedAssetTracker.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Misc/ScopedSlowTask.h"
 #include "CustomStyle/EditorExtensionStyle.h"
 #include "EditorExtensions/DebugUtils.h"
 #include "SlateWidgets/AdvancedDeletionWidget.h"
@@ -23,6 +42,21 @@ void FEditorExtensionsModule::StartupModule()
 {
 	UEditorUIScaleCustomizationSettings::InitUIScaleCustomizationSettings();
 
+	UnusedAssetTracker = MakeShared<FUnusedAssetTracker>();
+	UnusedAssetTracker->Initialize();
+
+	RedirectorFixupService = MakeShared<FRedirectorFixupService>();
+	RedirectorFixupService->Initialize();
+
+	AssetScanCache = MakeShared<FAssetScanCache>();
+	AssetScanCache->Load();
+
+	CompileExclusionRules();
+	DeletionSettingsChangedHandle = GetMutableDefault<UAssetDeletionSettings>()->OnSettingChanged().AddLambda([this](UObject*, FPropertyChangedEvent&)
+	{
+		CompileExclusionRules();
+	});
+
 	FEditorExtensionStyle::InitializeIcons();
 	InitCBMenuExtension();
 	RegisterAdvancedDeletionTab();
@@ -43,15 +77,47 @@ void FEditorExtensionsModule::ShutdownModule()
 	FEditorExtensionStyle::ShutDown();
 
 	UnRegisterSceneOutlinerColumn();
+
+	if (ActiveCleanupScan.IsValid())
+	{
+		ActiveCleanupScan->Cancel();
+		ActiveCleanupScan.Reset();
+	}
+
+	if (UnusedAssetTracker.IsValid())
+	{
+		UnusedAssetTracker->Shutdown();
+		UnusedAssetTracker.Reset();
+	}
+
+	if (RedirectorFixupService.IsValid())
+	{
+		RedirectorFixupService->Shutdown();
+		RedirectorFixupService.Reset();
+	}
+
+	if (AssetScanCache.IsValid())
+	{
+		if (AssetScanCache->IsDirty())
+		{
+			AssetScanCache->Save();
+		}
+		AssetScanCache.Reset();
+	}
+
+	if (UObjectInitialized())
+	{
+		GetMutableDefault<UAssetDeletionSettings>()->OnSettingChanged().Remove(DeletionSettingsChangedHandle);
+	}
 }
 bool FEditorExtensionsModule::DeleteAsset(const FAssetData& AssetData)
 {
 	const TArray<FAssetData> AssetArray = { AssetData };
 	return ObjectTools::DeleteAssets(AssetArray) != 0;
 }
-bool FEditorExtensionsModule::DeleteAssets(TArray<FAssetData> SelectedAssetData)
+bool FEditorExtensionsModule::DeleteAssets(const TArray<FAssetData>& SelectedAssetData)
 {
-	return ObjectTools::DeleteAssets(SelectedAssetData) != 0;
+	return FAssetBatchDeletion::DeleteAssets(SelectedAssetData) != 0;
 }
 TSharedRef<FExtender> FEditorExtensionsModule::CustomCBMenuExtender(const TArray<FString>& SelectedPaths)
 {
@@ -88,6 +154,13 @@ void FEditorExtensionsModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 		FSlateIcon(FEditorExtensionStyle::GetStyleSetName(), "ContentBrowser.DeleteUnusedAssets"),
 		FExecuteAction::CreateRaw(this, &FEditorExtensionsModule::OnDeleteUnusedAssets));
 
+	// Delete Unreachable Assets
+	MenuBuilder.AddMenuEntry(
+		FText::FromString(TEXT("Delete Unreachable Assets")),
+		FText::FromString(TEXT("Safety delete all assets under folder that can't be reached from maps, primary assets or always cooked directories")),
+		FSlateIcon(FEditorExtensionStyle::GetStyleSetName(), "ContentBrowser.DeleteUnusedAssets"),
+		FExecuteAction::CreateRaw(this, &FEditorExtensionsModule::OnDeleteUnreachableAssets));
+
 	// Delete Unused Folders and Assets
 	MenuBuilder.AddMenuEntry(
 		FText::FromString(TEXT("Delete Unused Folders and Assets")),
@@ -104,50 +177,60 @@ void FEditorExtensionsModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 }
 void FEditorExtensionsModule::OnDeleteUnusedAssets()
 {
-	if (FoldersPaths.Num() <= 0)
-	{
-		return;
-	}
-	if (FoldersPaths.Num() > 1)
+	if (!CanStartFolderCleanup())
 	{
-		DebugHelper::ShowMsgDialog(EAppMsgType::Ok, TEXT("For now you can only select one folder"));
 		return;
 	}
 
-	UAssetActionExtender::FixUpRedirectors();
+	const TArray<FString> CleanupRoots = GetSelectedCleanupRoots();
+	UAssetActionExtender::FixUpRedirectors(CleanupRoots);
 
-	DebugHelper::Print(TEXT("Currently running through folder: ") + FoldersPaths[ 0 ], FColor::Blue);
-	TArray<FString> AssetList = UEditorAssetLibrary::ListAssets(FoldersPaths[ 0 ]);
+	DebugHelper::Print(TEXT("Currently running through folders: ") + FString::Join(CleanupRoots, TEXT(", ")), FColor::Blue);
 
-	if (AssetList.IsEmpty())
+	LaunchIndexedCleanupScan(TEXT("Scanning for unused assets"), [this, CleanupRoots]()
+	{
+		DeleteUnusedAssetsUnderFolders(CleanupRoots);
+	});
+}
+void FEditorExtensionsModule::OnDeleteUnreachableAssets()
+{
+	if (!CanStartFolderCleanup())
 	{
-		DebugHelper::ShowNotifyInfo(TEXT("No asset found under selected folder"));
 		return;
 	}
 
-	TArray<FAssetData> UnusedAssetsData;
-	for (const FString& AssetPathName : AssetList)
+	const TArray<FString> CleanupRoots = GetSelectedCleanupRoots();
+	UAssetActionExtender::FixUpRedirectors(CleanupRoots);
+
+	LaunchIndexedCleanupScan(TEXT("Scanning for unreachable assets"), [this, CleanupRoots]()
 	{
-		if (AssetPathName.Contains(TEXT("Developers"))
-			|| AssetPathName.Contains(TEXT("Colletions"))
-			|| AssetPathName.Contains(TEXT("__ExternalActors__"))
-			|| AssetPathName.Contains(TEXT("__ExternalObjects__")))
-		{
-			DebugHelper::ShowNotifyInfo(TEXT("Don`t touch root folders"));
-			continue;
-		}
+		TArray<FAssetData> AssetsUnderFolder;
+		FAssetFolderEnumerator::GetAssetsUnderFolders(CleanupRoots, AssetsUnderFolder);
 
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName))
-		{
-			continue;
-		}
+		FAssetReachabilityAnalyzer ReachabilityAnalyzer;
+		ReachabilityAnalyzer.Analyze(UnusedAssetTracker->GetReferenceIndex());
 
-		TArray<FString> AssetsReferences = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
-		if (AssetsReferences.IsEmpty())
-		{
-			const FAssetData UnusedAssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-			UnusedAssetsData.Add(UnusedAssetData);
-		}
+		TArray<FAssetData> UnreachableAssetsData;
+		ReachabilityAnalyzer.FilterUnreachableAssets(AssetsUnderFolder, UnreachableAssetsData);
+
+		DeleteFoundAssets(UnreachableAssetsData);
+	});
+}
+void FEditorExtensionsModule::DeleteUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths)
+{
+	TArray<FAssetData> UnusedAssetsUnderFolder;
+	UnusedAssetTracker->GetUnusedAssetsUnderFolders(FolderPaths, UnusedAssetsUnderFolder);
+
+	DeleteFoundAssets(UnusedAssetsUnderFolder);
+}
+void FEditorExtensionsModule::DeleteFoundAssets(const TArray<FAssetData>& FoundAssetsData)
+{
+	TArray<FAssetData> UnusedAssetsData = FoundAssetsData;
+
+	const int32 NumExcludedAssets = ExclusionMatcher.RemoveExcludedAssets(UnusedAssetsData);
+	if (NumExcludedAssets > 0)
+	{
+		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Skipped %d assets in excluded folders"), NumExcludedAssets));
 	}
 
 	if (UnusedAssetsData.IsEmpty())
@@ -156,7 +239,7 @@ void FEditorExtensionsModule::OnDeleteUnusedAssets()
 		return;
 	}
 
-	const int32 NumOfDeletedAssets = ObjectTools::DeleteAssets(UnusedAssetsData);
+	const int32 NumOfDeletedAssets = FAssetBatchDeletion::DeleteAssets(UnusedAssetsData);
 
 	if (NumOfDeletedAssets > 0)
 	{
@@ -165,63 +248,182 @@ void FEditorExtensionsModule::OnDeleteUnusedAssets()
 }
 void FEditorExtensionsModule::OnEmptyFoldersAndAssetsDelete()
 {
-	OnDeleteUnusedAssets();
+	if (!CanStartFolderCleanup())
+	{
+		return;
+	}
 
-	UAssetActionExtender::FixUpRedirectors();
+	const TArray<FString> CleanupRoots = GetSelectedCleanupRoots();
+	UAssetActionExtender::FixUpRedirectors(CleanupRoots);
 
-	TArray<FString> FolderPathSelected = UEditorAssetLibrary::ListAssets(FoldersPaths[ 0 ], true, true);
-	uint32 FolderCounter = 0;
+	LaunchIndexedCleanupScan(TEXT("Scanning for unused assets"), [this, CleanupRoots]()
+	{
+		DeleteUnusedAssetsUnderFolders(CleanupRoots);
 
-	FString EmptyFolderPathsName;
-	TArray<FString> EmptyFolderPathsArray;
+		UAssetActionExtender::FixUpRedirectors(CleanupRoots);
 
-	for (const FString& FolderPath : FolderPathSelected)
+		LaunchEmptyFoldersScan(CleanupRoots);
+	});
+}
+bool FEditorExtensionsModule::CanStartFolderCleanup() const
+{
+	if (FoldersPaths.Num() <= 0)
 	{
-		if (FolderPath.Contains(TEXT("Developers"))
-			|| FolderPath.Contains(TEXT("Colletions"))
-			|| FolderPath.Contains(TEXT("__ExternalActors__"))
-			|| FolderPath.Contains(TEXT("__ExternalObjects__")))
-		{
-			DebugHelper::ShowNotifyInfo(TEXT("Don`t touch root folders"));
-			continue;
-		}
+		return false;
+	}
+	if (ActiveCleanupScan.IsValid() && !ActiveCleanupScan->IsFinished())
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("Another cleanup scan is still running"));
+		return false;
+	}
+	return true;
+}
+TArray<FString> FEditorExtensionsModule::GetSelectedCleanupRoots() const
+{
+	TArray<FString> SelectedPaths;
+	for (FString FolderPath : FoldersPaths)
+	{
+		FolderPath.RemoveFromEnd(TEXT("/"));
+		SelectedPaths.AddUnique(MoveTemp(FolderPath));
+	}
+
+	// Parents first, so a folder nested in another selected folder is dropped instead of being scanned twice
+	SelectedPaths.Sort([](const FString& A, const FString& B)
+	{
+		return A.Len() < B.Len();
+	});
 
-		if (!UEditorAssetLibrary::DoesDirectoryExist(FolderPath))
+	TArray<FString> CleanupRoots;
+	for (const FString& SelectedPath : SelectedPaths)
+	{
+		const bool bIsNested = CleanupRoots.ContainsByPredicate([&SelectedPath](const FString& CleanupRoot)
 		{
-			continue;
-		}
+			return SelectedPath.StartsWith(CleanupRoot + TEXT("/"));
+		});
 
-		if (!UEditorAssetLibrary::DoesDirectoryHaveAssets(FolderPath))
+		if (!bIsNested)
 		{
-			EmptyFolderPathsName.Append(FolderPath + TEXT("\n"));
-			EmptyFolderPathsArray.Add(FolderPath);
+			CleanupRoots.Add(SelectedPath);
 		}
 	}
-
-	if (EmptyFolderPathsArray.IsEmpty())
+	return CleanupRoots;
+}
+void FEditorExtensionsModule::LaunchIndexedCleanupScan(const FString& ScanTitle, TUniqueFunction<void()>&& OnIndexReady)
+{
+	// The first scan of a session builds the reference index on the thread pool, later ones find it ready
+	TSharedPtr<FAssetReferenceIndex> BuiltIndex;
+	if (UnusedAssetTracker->NeedsIndexBuild())
 	{
-		DebugHelper::ShowNotifyInfo(TEXT("No unused folder found under selected folder"));
-		return;
+		BuiltIndex = MakeShared<FAssetReferenceIndex>();
+		UnusedAssetTracker->BeginExternalIndexBuild();
 	}
 
-	const EAppReturnType::Type ConfirmReturn = DebugHelper::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Found ") + FString::FromInt(EmptyFolderPathsArray.Num()) + "\nList: " + EmptyFolderPathsName + "\n\nConfirm to delete?");
-
-	if (ConfirmReturn == EAppReturnType::Cancel)
-	{
-		return;
-	}
-	for (const FString& EmptyFolderPath : EmptyFolderPathsArray)
+	ActiveCleanupScan = FAssetCleanupScan::Launch(
+		FText::FromString(ScanTitle),
+		[BuiltIndex](FAssetScanProgress& Progress)
+		{
+			if (BuiltIndex.IsValid())
+			{
+				BuiltIndex->Build(&Progress);
+			}
+		},
+		[this, BuiltIndex, OnIndexReady = MoveTemp(OnIndexReady)]() mutable
+		{
+			if (BuiltIndex.IsValid())
+			{
+				UnusedAssetTracker->AdoptIndex(MoveTemp(*BuiltIndex));
+			}
+			OnIndexReady();
+		});
+}
+void FEditorExtensionsModule::LaunchEmptyFoldersScan(const TArray<FString>& FolderPaths)
+{
+	struct FEmptyFoldersScanResult
 	{
-		if (UEditorAssetLibrary::DeleteDirectory(EmptyFolderPath))
+		TArray<FString> EmptySubtreeRoots;
+		int32 NumEmptyFolders = 0;
+		int32 NumProtectedFolders = 0;
+	};
+	TSharedRef<FEmptyFoldersScanResult> ScanResult = MakeShared<FEmptyFoldersScanResult>();
+
+	ActiveCleanupScan = FAssetCleanupScan::Launch(
+		FText::FromString(TEXT("Scanning for empty folders")),
+		[FolderPaths, ScanResult, Matcher = ExclusionMatcher](FAssetScanProgress& Progress)
 		{
-			++FolderCounter;
-		}
-	}
-	DebugHelper::ShowNotifyInfo("Successfully deleted " + FString::FromInt(FolderCounter) + " folders.");
+			// Roots are disjoint, each one is scanned on its own worker into its own tree
+			const int32 NumRoots = FolderPaths.Num();
+			TArray<FEmptyFolderTree> TreePerRoot;
+			TreePerRoot.SetNum(NumRoots);
+
+			ParallelFor(
+				NumRoots,
+				[&](const int32 RootIndex)
+				{
+					TreePerRoot[ RootIndex ].Build(FolderPaths[ RootIndex ], Matcher, Progress);
+				},
+				NumRoots == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+
+			for (const FEmptyFolderTree& RootTree : TreePerRoot)
+			{
+				ScanResult->EmptySubtreeRoots.Append(RootTree.GetEmptySubtreeRoots());
+				ScanResult->NumEmptyFolders += RootTree.GetNumEmptyFolders();
+				ScanResult->NumProtectedFolders += RootTree.GetNumExcludedFolders();
+			}
+		},
+		[ScanResult]()
+		{
+			if (ScanResult->NumProtectedFolders > 0)
+			{
+				DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Skipped %d excluded folders"), ScanResult->NumProtectedFolders));
+			}
+
+			const TArray<FString>& EmptySubtreeRoots = ScanResult->EmptySubtreeRoots;
+			if (EmptySubtreeRoots.IsEmpty())
+			{
+				DebugHelper::ShowNotifyInfo(TEXT("No unused folder found under selected folders"));
+				return;
+			}
+
+			// Only the topmost empty folders are listed and deleted, everything below them goes with them
+			const FString EmptyFolderPathsName = FString::Join(EmptySubtreeRoots, TEXT("\n"));
+			const EAppReturnType::Type ConfirmReturn = DebugHelper::ShowMsgDialog(EAppMsgType::OkCancel, TEXT("Found ") + FString::FromInt(ScanResult->NumEmptyFolders) + "\nList: " + EmptyFolderPathsName + "\n\nConfirm to delete?");
+
+			if (ConfirmReturn == EAppReturnType::Cancel)
+			{
+				return;
+			}
+
+			uint32 FolderCounter = 0;
+			uint32 SkippedFolderCounter = 0;
+			for (const FString& EmptySubtreeRoot : EmptySubtreeRoots)
+			{
+				// The scan only saw assets on disk, a folder holding unsaved or newly created assets is not empty
+				if (UEditorAssetLibrary::DoesDirectoryHaveAssets(EmptySubtreeRoot, true))
+				{
+					++SkippedFolderCounter;
+					continue;
+				}
+
+				if (UEditorAssetLibrary::DeleteDirectory(EmptySubtreeRoot))
+				{
+					++FolderCounter;
+				}
+			}
+			DebugHelper::ShowNotifyInfo("Successfully deleted " + FString::FromInt(FolderCounter) + " folders.");
+
+			if (SkippedFolderCounter > 0)
+			{
+				DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Kept %d folders that now contain assets"), SkippedFolderCounter));
+			}
+		});
+}
+void FEditorExtensionsModule::CompileExclusionRules()
+{
+	ExclusionMatcher.Compile(GetDefault<UAssetDeletionSettings>()->ExclusionRules);
 }
 void FEditorExtensionsModule::OnAdvancedDeletion()
 {
-	UAssetActionExtender::FixUpRedirectors();
+	UAssetActionExtender::FixUpRedirectors(GetSelectedCleanupRoots());
 
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvancedDeletion"));
 }
@@ -240,41 +442,10 @@ TSharedRef<SDockTab> FEditorExtensionsModule::OnSpawnAdvanceDeletion(const FSpaw
 		return SNew(SDockTab).TabRole(NomadTab);
 	}
 	
+	// The tab opens empty and fills in while the folders are listed in the background
 	return SNew(SDockTab).TabRole(ETabRole::NomadTab)
 		[ SNew(SAdvanceDeletionsTab)
-			  .AssetsDataToStore(GetAllAssetDataUnderSelectedFolder()) ];
-}
-TArray<TSharedPtr<FAssetData>> FEditorExtensionsModule::GetAllAssetDataUnderSelectedFolder()
-{
-	TArray<TSharedPtr<FAssetData>> AvailableAssetData;
-
-	if (FoldersPaths.IsEmpty())
-	{
-		return AvailableAssetData;
-	}
-
-	TArray<FString> AssetPathNames = UEditorAssetLibrary::ListAssets(FoldersPaths[ 0 ]);
-
-	for (const FString& AssetPath : AssetPathNames)
-	{
-		if (AssetPath.Contains(TEXT("Developers"))
-			|| AssetPath.Contains(TEXT("Colletions"))
-			|| AssetPath.Contains(TEXT("__ExternalActors__"))
-			|| AssetPath.Contains(TEXT("__ExternalObjects__")))
-		{
-			DebugHelper::ShowNotifyInfo(TEXT("Don`t touch root folders"));
-			continue;
-		}
-
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPath))
-		{
-			continue;
-		}
-
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPath);
-		AvailableAssetData.Add(MakeShared<FAssetData>(Data));
-	}
-	return AvailableAssetData;
+			  .AssetStream(FAssetFolderStream::Launch(GetSelectedCleanupRoots(), ExclusionMatcher)) ];
 }
 void FEditorExtensionsModule::InitLevelEditorExtension()
 {
@@ -507,48 +678,390 @@ void FEditorExtensionsModule::UnRegisterSceneOutlinerColumn()
 void FEditorExtensionsModule::GetUnusedAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData)
 {
 	FilteredAssetData.Empty();
+	UnusedAssetTracker->FilterUnusedAssets(AssetDataToFilter, FilteredAssetData);
+}
+void FEditorExtensionsModule::GetUnreachableAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData)
+{
+	FilteredAssetData.Empty();
+
+	FAssetReachabilityAnalyzer ReachabilityAnalyzer;
+	ReachabilityAnalyzer.Analyze(UnusedAssetTracker->GetReferenceIndex());
+	ReachabilityAnalyzer.FilterUnreachableAssets(AssetDataToFilter, FilteredAssetData);
+}
+FUnusedAssetTracker& FEditorExtensionsModule::GetUnusedAssetTracker() const
+{
+	return *UnusedAssetTracker;
+}
+FRedirectorFixupService& FEditorExtensionsModule::GetRedirectorFixupService() const
+{
+	return *RedirectorFixupService;
+}
+FAssetScanCache& FEditorExtensionsModule::GetAssetScanCache() const
+{
+	return *AssetScanCache;
+}
+void FEditorExtensionsModule::GetDuplicatedAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData)
+{
+	FilteredAssetData.Empty();
+
+	TArray<FAssetDuplicateGroup> DuplicateGroups;
+	GetDuplicatedAssetGroups(AssetDataToFilter, DuplicateGroups);
+
+	for (FAssetDuplicateGroup& Group : DuplicateGroups)
+	{
+		FilteredAssetData.Append(MoveTemp(Group.Assets));
+	}
+}
+void FEditorExtensionsModule::GetDuplicatedAssetGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<FAssetDuplicateGroup>& OutGroups)
+{
+	FAssetDuplicateGrouper::GroupByName(AssetDataToFilter, OutGroups);
+}
+bool FEditorExtensionsModule::IsCleanupScanRunning() const
+{
+	return ActiveCleanupScan.IsValid() && !ActiveCleanupScan->IsFinished();
+}
+void FEditorExtensionsModule::FindContentDuplicatedAssetGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<FAssetDuplicateGroup>&&)>&& OnFound)
+{
+	if (ActiveCleanupScan.IsValid() && !ActiveCleanupScan->IsFinished())
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("Another cleanup scan is still running"));
+		return;
+	}
+
+	struct FContentHashScanResult
+	{
+		TArray<FName> PackageNames;
+		TMap<FName, uint64> PackageHashes;
+		TMap<FName, FAssetScanCacheEntry> NewCacheEntries;
+	};
+	TSharedRef<FContentHashScanResult> ScanResult = MakeShared<FContentHashScanResult>();
+
+	TSet<FName> UniquePackageNames;
 	for (const TSharedPtr<FAssetData>& Data : AssetDataToFilter)
 	{
-		TArray<FString> AssetRef =
-			UEditorAssetLibrary::FindPackageReferencersForAsset(Data->GetObjectPathString());
+		if (Data.IsValid())
+		{
+			UniquePackageNames.Add(Data->PackageName);
+		}
+	}
+	ScanResult->PackageNames = UniquePackageNames.Array();
 
-		if (!AssetRef.IsEmpty())
+	ActiveCleanupScan = FAssetCleanupScan::Launch(
+		FText::FromString(TEXT("Hashing package contents")),
+		[ScanResult, Cache = AssetScanCache](FAssetScanProgress& Progress)
+		{
+			// The cache is only written on the game thread once the scan is over
+			FAssetContentHasher::HashPackages(ScanResult->PackageNames, ScanResult->PackageHashes, &Progress, Cache.Get(), &ScanResult->NewCacheEntries);
+		},
+		[this, ScanResult, AssetDataToFilter, OnFound = MoveTemp(OnFound)]()
+		{
+			if (!ScanResult->NewCacheEntries.IsEmpty())
+			{
+				for (const TPair<FName, FAssetScanCacheEntry>& NewEntry : ScanResult->NewCacheEntries)
+				{
+					AssetScanCache->Store(NewEntry.Key, NewEntry.Value);
+				}
+				AssetScanCache->Save();
+			}
+
+			TArray<FAssetDuplicateGroup> DuplicateGroups;
+			FAssetDuplicateGrouper::GroupByContentHash(AssetDataToFilter, ScanResult->PackageHashes, DuplicateGroups);
+			OnFound(MoveTemp(DuplicateGroups));
+		});
+}
+void FEditorExtensionsModule::FindSimilarTextureGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<FAssetDuplicateGroup>&&)>&& OnFound)
+{
+	if (ActiveCleanupScan.IsValid() && !ActiveCleanupScan->IsFinished())
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("Another cleanup scan is still running"));
+		return;
+	}
+
+	struct FTextureHashScanResult
+	{
+		// Parallel arrays, one slot per texture that has to be hashed
+		TArray<FName> PackageNames;
+		TArray<FTextureSource> Sources;
+		TArray<FAssetScanCacheEntry> NewCacheEntries;
+		TArray<TOptional<uint64>> Hashes;
+	};
+	TSharedRef<FTextureHashScanResult> ScanResult = MakeShared<FTextureHashScanResult>();
+
+	TMap<FName, uint64> PackageHashes;
+	TMap<FName, int64> TextureMemorySizes;
+	TArray<TSharedPtr<FAssetData>> TexturesToLoad;
+
+	TSet<FName> VisitedPackages;
+	for (const TSharedPtr<FAssetData>& Data : AssetDataToFilter)
+	{
+		if (!Data.IsValid() || !Data->IsInstanceOf(UTexture::StaticClass()))
+		{
+			continue;
+		}
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(Data->PackageName, &bAlreadyVisited);
+		if (bAlreadyVisited)
 		{
 			continue;
 		}
 
-		FilteredAssetData.Add(Data);
+		FString Filename;
+		FFileStatData StatData;
+		if (!FAssetContentHasher::FindPackageFile(Data->PackageName, Filename, StatData))
+		{
+			continue;
+		}
+
+		// Unchanged textures are neither loaded nor hashed again
+		const FAssetScanCacheEntry* CachedEntry = AssetScanCache->FindValid(Data->PackageName, StatData);
+		if (CachedEntry && EnumHasAnyFlags(CachedEntry->ValidFields, EAssetScanCacheField::PerceptualHash))
+		{
+			PackageHashes.Add(Data->PackageName, CachedEntry->PerceptualHash);
+			TextureMemorySizes.Add(Data->PackageName, CachedEntry->TextureMemorySize);
+			continue;
+		}
+
+		FAssetScanCacheEntry& NewEntry = ScanResult->NewCacheEntries.AddDefaulted_GetRef();
+		NewEntry.FileSize = StatData.FileSize;
+		NewEntry.ModifiedTicks = StatData.ModificationTime.GetTicks();
+		NewEntry.ValidFields = EAssetScanCacheField::PerceptualHash;
+		ScanResult->PackageNames.Add(Data->PackageName);
+		TexturesToLoad.Add(Data);
 	}
+
+	// Loading has to happen here. The workers read torn off copies of the sources, which don't change when the
+	// texture is edited and don't keep it loaded.
+	ScanResult->Sources.SetNum(TexturesToLoad.Num());
+	{
+		FScopedSlowTask SlowTask(TexturesToLoad.Num(), FText::FromString(TEXT("Loading textures")));
+		SlowTask.MakeDialogDelayed(.5f, true);
+
+		for (int32 TextureIndex = 0; TextureIndex < TexturesToLoad.Num(); ++TextureIndex)
+		{
+			if (SlowTask.ShouldCancel())
+			{
+				return;
+			}
+			SlowTask.EnterProgressFrame();
+
+			UTexture* Texture = Cast<UTexture>(TexturesToLoad[ TextureIndex ]->GetAsset());
+			if (Texture)
+			{
+				ScanResult->NewCacheEntries[ TextureIndex ].TextureMemorySize = Texture->CalcTextureMemorySizeEnum(TMC_AllMips);
+				ScanResult->Sources[ TextureIndex ] = Texture->Source.CopyTornOff();
+			}
+		}
+	}
+
+	ActiveCleanupScan = FAssetCleanupScan::Launch(
+		FText::FromString(TEXT("Hashing textures")),
+		[ScanResult](FAssetScanProgress& Progress)
+		{
+			FTexturePerceptualHasher::HashTextures(ScanResult->Sources, ScanResult->Hashes, &Progress);
+		},
+		[this, ScanResult, PackageHashes = MoveTemp(PackageHashes), TextureMemorySizes = MoveTemp(TextureMemorySizes),
+			AssetDataToFilter, OnFound = MoveTemp(OnFound)]() mutable
+		{
+			bool bCacheChanged = false;
+			for (int32 TextureIndex = 0; TextureIndex < ScanResult->Hashes.Num(); ++TextureIndex)
+			{
+				if (!ScanResult->Hashes[ TextureIndex ].IsSet())
+				{
+					continue;
+				}
+
+				const FName PackageName = ScanResult->PackageNames[ TextureIndex ];
+				FAssetScanCacheEntry& NewEntry = ScanResult->NewCacheEntries[ TextureIndex ];
+				NewEntry.PerceptualHash = ScanResult->Hashes[ TextureIndex ].GetValue();
+
+				PackageHashes.Add(PackageName, NewEntry.PerceptualHash);
+				TextureMemorySizes.Add(PackageName, NewEntry.TextureMemorySize);
+				AssetScanCache->Store(PackageName, NewEntry);
+				bCacheChanged = true;
+			}
+			if (bCacheChanged)
+			{
+				AssetScanCache->Save();
+			}
+
+			TArray<FAssetDuplicateGroup> SimilarGroups;
+			FAssetDuplicateGrouper::GroupByNearHash(AssetDataToFilter, PackageHashes, GetDefault<UAssetDeletionSettings>()->SimilarTextureMaxDistance, SimilarGroups);
+
+			// Keeping the largest texture of each group and pointing users of the rest at it frees the others
+			int64 TotalReclaimableMemory = 0;
+			for (FAssetDuplicateGroup& Group : SimilarGroups)
+			{
+				int64 GroupMemory = 0;
+				int64 LargestMemory = 0;
+				for (const TSharedPtr<FAssetData>& Data : Group.Assets)
+				{
+					const int64 TextureMemory = TextureMemorySizes.FindRef(Data->PackageName);
+					GroupMemory += TextureMemory;
+					LargestMemory = FMath::Max(LargestMemory, TextureMemory);
+				}
+				Group.ReclaimableMemory = GroupMemory - LargestMemory;
+				TotalReclaimableMemory += Group.ReclaimableMemory;
+			}
+
+			if (!SimilarGroups.IsEmpty())
+			{
+				DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("%d groups of similar textures, about %s of texture memory could be reclaimed"),
+					SimilarGroups.Num(), *FText::AsMemory(TotalReclaimableMemory).ToString()));
+			}
+
+			OnFound(MoveTemp(SimilarGroups));
+		});
 }
-void FEditorExtensionsModule::GetDuplicatedAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData)
+void FEditorExtensionsModule::FindIdenticalMeshGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<FAssetDuplicateGroup>&&)>&& OnFound)
 {
-	FilteredAssetData.Empty();
-
-	TMultiMap<FString, TSharedPtr<FAssetData>> AssetsInfoMultiMap;
+	if (ActiveCleanupScan.IsValid() && !ActiveCleanupScan->IsFinished())
+	{
+		DebugHelper::ShowNotifyInfo(TEXT("Another cleanup scan is still running"));
+		return;
+	}
 
+	struct FMeshHashScanResult
+	{
+		// Parallel arrays, one slot per mesh whose geometry has to be hashed
+		TArray<FName> PackageNames;
+		TArray<TOptional<FStaticMeshSignature::FGeometry>> Geometries;
+		TArray<FAssetScanCacheEntry> NewCacheEntries;
+		TArray<TOptional<uint64>> Hashes;
+	};
+	TSharedRef<FMeshHashScanResult> ScanResult = MakeShared<FMeshHashScanResult>();
+
+	TMap<FName, uint64> PackageTagKeys;
+	TMap<uint64, int32> NumMeshesByTagKey;
+	TArray<TSharedPtr<FAssetData>> MeshAssets;
+
+	TSet<FName> VisitedPackages;
 	for (const TSharedPtr<FAssetData>& Data : AssetDataToFilter)
 	{
-		AssetsInfoMultiMap.Emplace(Data->AssetName.ToString(), Data);
+		if (!Data.IsValid() || !Data->IsInstanceOf(UStaticMesh::StaticClass()))
+		{
+			continue;
+		}
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(Data->PackageName, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+
+		uint64 TagKey = 0;
+		if (!FStaticMeshSignature::GetTagKey(*Data, TagKey))
+		{
+			// Packages saved without the geometry tags have to be loaded to get them
+			const UStaticMesh* StaticMesh = Cast<UStaticMesh>(Data->GetAsset());
+			if (!StaticMesh || !FStaticMeshSignature::GetTagKey(FAssetData(StaticMesh), TagKey))
+			{
+				continue;
+			}
+		}
+
+		PackageTagKeys.Add(Data->PackageName, TagKey);
+		++NumMeshesByTagKey.FindOrAdd(TagKey);
+		MeshAssets.Add(Data);
 	}
 
-	for (const TSharedPtr<FAssetData>& Data : AssetDataToFilter)
+	TMap<FName, uint64> PackageSignatures;
+	TArray<TSharedPtr<FAssetData>> MeshesToLoad;
+	for (const TSharedPtr<FAssetData>& Data : MeshAssets)
 	{
-		TArray<TSharedPtr<FAssetData>> OutAssetData;
-		AssetsInfoMultiMap.MultiFind(Data->AssetName.ToString(), OutAssetData);
+		// A mesh with tags nobody else has can't have a copy
+		const uint64 TagKey = PackageTagKeys.FindChecked(Data->PackageName);
+		if (NumMeshesByTagKey.FindChecked(TagKey) < 2)
+		{
+			continue;
+		}
+
+		FString Filename;
+		FFileStatData StatData;
+		if (!FAssetContentHasher::FindPackageFile(Data->PackageName, Filename, StatData))
+		{
+			continue;
+		}
 
-		if (OutAssetData.Num() <= 1)
+		const FAssetScanCacheEntry* CachedEntry = AssetScanCache->FindValid(Data->PackageName, StatData);
+		if (CachedEntry && EnumHasAnyFlags(CachedEntry->ValidFields, EAssetScanCacheField::GeometryHash))
 		{
+			PackageSignatures.Add(Data->PackageName, FStaticMeshSignature::CombineKeys(TagKey, CachedEntry->GeometryHash));
 			continue;
 		}
 
-		for (const TSharedPtr<FAssetData>& SameData : OutAssetData)
+		FAssetScanCacheEntry& NewEntry = ScanResult->NewCacheEntries.AddDefaulted_GetRef();
+		NewEntry.FileSize = StatData.FileSize;
+		NewEntry.ModifiedTicks = StatData.ModificationTime.GetTicks();
+		NewEntry.ValidFields = EAssetScanCacheField::GeometryHash;
+		ScanResult->PackageNames.Add(Data->PackageName);
+		MeshesToLoad.Add(Data);
+	}
+
+	// Same split as the texture scan: load and copy the geometry here, hash the copies on the workers
+	ScanResult->Geometries.SetNum(MeshesToLoad.Num());
+	{
+		FScopedSlowTask SlowTask(MeshesToLoad.Num(), FText::FromString(TEXT("Loading static meshes")));
+		SlowTask.MakeDialogDelayed(.5f, true);
+
+		for (int32 MeshIndex = 0; MeshIndex < MeshesToLoad.Num(); ++MeshIndex)
 		{
-			if (SameData.IsValid())
+			if (SlowTask.ShouldCancel())
+			{
+				return;
+			}
+			SlowTask.EnterProgressFrame();
+
+			UStaticMesh* StaticMesh = Cast<UStaticMesh>(MeshesToLoad[ MeshIndex ]->GetAsset());
+			const FMeshDescription* MeshDescription = StaticMesh ? StaticMesh->GetMeshDescription(0) : nullptr;
+			FStaticMeshSignature::FGeometry Geometry;
+			if (MeshDescription && FStaticMeshSignature::ExtractGeometry(*MeshDescription, Geometry))
 			{
-				FilteredAssetData.AddUnique(SameData);
+				ScanResult->Geometries[ MeshIndex ] = MoveTemp(Geometry);
 			}
 		}
 	}
+
+	ActiveCleanupScan = FAssetCleanupScan::Launch(
+		FText::FromString(TEXT("Hashing static meshes")),
+		[ScanResult](FAssetScanProgress& Progress)
+		{
+			FStaticMeshSignature::HashGeometries(ScanResult->Geometries, ScanResult->Hashes, &Progress);
+		},
+		[this, ScanResult, PackageTagKeys = MoveTemp(PackageTagKeys), PackageSignatures = MoveTemp(PackageSignatures),
+			AssetDataToFilter, OnFound = MoveTemp(OnFound)]() mutable
+		{
+			bool bCacheChanged = false;
+			for (int32 MeshIndex = 0; MeshIndex < ScanResult->Hashes.Num(); ++MeshIndex)
+			{
+				if (!ScanResult->Hashes[ MeshIndex ].IsSet())
+				{
+					continue;
+				}
+
+				const FName PackageName = ScanResult->PackageNames[ MeshIndex ];
+				FAssetScanCacheEntry& NewEntry = ScanResult->NewCacheEntries[ MeshIndex ];
+				NewEntry.GeometryHash = ScanResult->Hashes[ MeshIndex ].GetValue();
+
+				PackageSignatures.Add(PackageName, FStaticMeshSignature::CombineKeys(PackageTagKeys.FindChecked(PackageName), NewEntry.GeometryHash));
+				AssetScanCache->Store(PackageName, NewEntry);
+				bCacheChanged = true;
+			}
+			if (bCacheChanged)
+			{
+				AssetScanCache->Save();
+			}
+
+			TArray<FAssetDuplicateGroup> IdenticalGroups;
+			FAssetDuplicateGrouper::GroupByContentHash(AssetDataToFilter, PackageSignatures, IdenticalGroups);
+
+			// Copies share their geometry, so each one is about the same size
+			for (FAssetDuplicateGroup& Group : IdenticalGroups)
+			{
+				Group.ReclaimableMemory = Group.TotalDiskSize - Group.TotalDiskSize / Group.Assets.Num();
+			}
+
+			OnFound(MoveTemp(IdenticalGroups));
+		});
 }
 void FEditorExtensionsModule::SyncCBToClickedAsset(const FString& AssetPath)
 {
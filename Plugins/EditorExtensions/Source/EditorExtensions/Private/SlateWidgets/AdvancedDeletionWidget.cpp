@@ -4,25 +4,121 @@
 
 #include "EditorExtensions.h"
 #include "AssetActions/AssetActionExtender.h"
+#include "AssetActions/AssetFolderStream.h"
+#include "AssetActions/RedirectorFixupService.h"
+#include "AssetDeletion/AssetFileStatScan.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "AssetDeletion/AssetSortKeys.h"
+#include "AssetDeletion/AssetTextFilterIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "EditorExtensions/DebugUtils.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SExpanderArrow.h"
 
 #define ListALL TEXT("All Assets")
 #define ListUnused TEXT("Unused Assets")
 #define ListDuplicated TEXT("Duplicated Assets")
+#define ListIdenticalContent TEXT("Identical Content Assets")
+#define ListUnreachable TEXT("Unreachable Assets")
+#define ListSimilarTextures TEXT("Similar Textures")
+#define ListIdenticalMeshes TEXT("Identical Static Meshes")
+
+namespace AdvancedDeletionWidget
+{
+	const FName CheckColumn(TEXT("Check"));
+	const FName NameColumn(TEXT("Name"));
+	const FName ClassColumn(TEXT("Class"));
+	const FName GroupColumn(TEXT("Group"));
+	const FName PathColumn(TEXT("Path"));
+	const FName SizeColumn(TEXT("Size"));
+	const FName ModifiedColumn(TEXT("Modified"));
+	const FName ReferencersColumn(TEXT("Referencers"));
+	const FName DeleteColumn(TEXT("Delete"));
+
+	// Seconds between checks whether a queued hashed view can start
+	constexpr float QueuedHashedViewPollInterval = 0.25f;
+
+	// Streamed assets taken per frame, a folder is never split so a frame may take more
+	constexpr int32 StreamedAssetsPerFrame = 2000;
+	// The text index is rebuilt whenever the list doubles, but not for fewer assets than this
+	constexpr int32 StreamedAssetsPerTextIndexBuild = 4096;
+
+	DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FOnGenerateAssetCell, const FName& /*ColumnName*/, const TSharedRef<ITableRow>& /*Row*/);
+
+	// Cells are only built for the header's columns, and the list view recycles the rows themselves
+	class SAssetRow : public SMultiColumnTableRow<TSharedPtr<FAssetData>>
+	{
+	public:
+		SLATE_BEGIN_ARGS(SAssetRow) {}
+
+		SLATE_EVENT(FOnGenerateAssetCell, OnGenerateCell)
+
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+		{
+			OnGenerateCell = InArgs._OnGenerateCell;
+			SMultiColumnTableRow<TSharedPtr<FAssetData>>::Construct(FSuperRowType::FArguments().Padding(FMargin(2.f)), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+		{
+			return OnGenerateCell.Execute(ColumnName, SharedThis(this));
+		}
+
+	private:
+		FOnGenerateAssetCell OnGenerateCell;
+	};
+
+	// Views grouped by a module cleanup scan, of which only one runs at a time
+	bool IsHashedListOption(const TSharedPtr<FString>& ListOption)
+	{
+		return ListOption.IsValid() && (*ListOption.Get() == ListIdenticalContent || *ListOption.Get() == ListSimilarTextures || *ListOption.Get() == ListIdenticalMeshes);
+	}
+}
 
 void SAdvanceDeletionsTab::Construct(const FArguments& InArgs)
 {
 	bCanSupportFocus = true;
 
 	StoredAssetsData = InArgs._AssetsDataToStore;
-	DisplayedAssetsData = StoredAssetsData;
+	for (const TSharedPtr<FAssetData>& AssetData : StoredAssetsData)
+	{
+		ListedRootPaths.AddUnique(AssetData->PackagePath.ToString());
+	}
+	ViewAssetsData = StoredAssetsData;
+	RebuildStoredAssetIndices();
+	RebuildDisplayedAssets();
+	BuildTextFilterIndex();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSP(this, &SAdvanceDeletionsTab::OnAssetRegistryChanged);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddSP(this, &SAdvanceDeletionsTab::OnAssetRegistryChanged);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddSP(this, &SAdvanceDeletionsTab::OnAssetRegistryRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddSP(this, &SAdvanceDeletionsTab::OnAssetRegistryChanged);
+
+	AssetStream = InArgs._AssetStream;
+	if (AssetStream.IsValid())
+	{
+		ListedRootPaths = AssetStream->GetRootPaths();
+		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvanceDeletionsTab::PumpAssetStream));
+	}
 
 	FSlateFontInfo TitleTextFont = GetEmbossedTextFont();
 	TitleTextFont.Size = 30;
 
+	RowTextFont = GetEmbossedTextFont();
+	RowTextFont.Size = 7;
+
 	ComboSourceItems.Empty();
 	ComboSourceItems.Add(MakeShared<FString>(ListALL));
 	ComboSourceItems.Add(MakeShared<FString>(ListUnused));
 	ComboSourceItems.Add(MakeShared<FString>(ListDuplicated));
+	ComboSourceItems.Add(MakeShared<FString>(ListIdenticalContent));
+	ComboSourceItems.Add(MakeShared<FString>(ListUnreachable));
+	ComboSourceItems.Add(MakeShared<FString>(ListSimilarTextures));
+	ComboSourceItems.Add(MakeShared<FString>(ListIdenticalMeshes));
 
 	ChildSlot
 		[
@@ -49,51 +145,113 @@ void SAdvanceDeletionsTab::Construct(const FArguments& InArgs)
 
 						+ SHorizontalBox::Slot()
 							  .AutoWidth()
-								  [ ConstructComboBox() ] ]
+								  [ ConstructComboBox() ]
+
+						+ SHorizontalBox::Slot()
+							  .AutoWidth()
+								  [ ConstructInvertSelectionButton() ]
+
+						+ SHorizontalBox::Slot()
+							  .FillWidth(1.f)
+								  [ ConstructSearchBox() ] ]
 
 			// AssetList
+			// The list view scrolls and virtualizes its own rows, it must not sit in a scroll box
 			+ SVerticalBox::Slot()
-				  .VAlign(VAlign_Fill)
-					  [ SNew(SScrollBox)
-
-						+ SScrollBox::Slot()
-							[ ConstructAssetListView() ] ]
+				  .FillHeight(1.f)
+					  [ ConstructAssetListView() ]
 
 			// Buttons
 			+ SVerticalBox::Slot()
 				  .AutoHeight()
 					  [ SNew(SHorizontalBox)
 						+ SHorizontalBox::Slot()
-							[ ConstructDeleteSelectedButton() ] ]
+							[ ConstructDeleteSelectedButton() ]
+
+						+ SHorizontalBox::Slot()
+							  .AutoWidth()
+							  .VAlign(VAlign_Center)
+							  .Padding(FMargin(8.f, 0.f))
+								  [ SNew(STextBlock)
+										.Text(this, &SAdvanceDeletionsTab::GetAssetCountText) ]
+
+						+ SHorizontalBox::Slot()
+							  .AutoWidth()
+							  .VAlign(VAlign_Center)
+							  .Padding(FMargin(8.f, 0.f))
+								  [ SNew(STextBlock)
+										.Text(this, &SAdvanceDeletionsTab::GetReclaimableText) ] ]
 
 	];
 }
+SAdvanceDeletionsTab::~SAdvanceDeletionsTab()
+{
+	if (AssetStream.IsValid())
+	{
+		AssetStream->Cancel();
+	}
+	if (FileStatProgress.IsValid())
+	{
+		FileStatProgress->RequestCancel();
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+}
 FSlateFontInfo SAdvanceDeletionsTab::GetEmbossedTextFont() const
 {
 	return FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
 }
 void SAdvanceDeletionsTab::RefreshAssetListView()
 {
-	UAssetActionExtender::FixUpRedirectors();
+	// Usually nothing is pending, and the scope is the tab's roots rather than every listed asset's folder
+	const FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
+	if (EditorExtensionsModule.GetRedirectorFixupService().HasPendingRedirectors())
+	{
+		UAssetActionExtender::FixUpRedirectors(ListedRootPaths);
+	}
 
-	SelectedAssetData.Empty();
-	CheckBoxesArray.Empty();
+	ClearSelection();
 	if (!ConstructedAssetListView.IsValid())
 	{
 		return;
 	}
+	ConstructedAssetListView->RequestTreeRefresh();
 	ConstructedAssetListView->RebuildList();
 }
-TSharedRef<SListView<TSharedPtr<FAssetData>>> SAdvanceDeletionsTab::ConstructAssetListView()
+TSharedRef<STreeView<TSharedPtr<FAssetData>>> SAdvanceDeletionsTab::ConstructAssetListView()
 {
-	ConstructedAssetListView = SNew(SListView<TSharedPtr<FAssetData>>)
+	ConstructedAssetListView = SNew(STreeView<TSharedPtr<FAssetData>>)
 								   .ItemHeight(24.f)
-								   .ListItemsSource(&DisplayedAssetsData)
+								   .TreeItemsSource(&DisplayedAssetsData)
 								   .OnGenerateRow(this, &SAdvanceDeletionsTab::OnGenerateRowForList)
-								   .OnMouseButtonClick(this, &SAdvanceDeletionsTab::OnRowWidgetMouseButtonClicked);
+								   .OnGetChildren(this, &SAdvanceDeletionsTab::OnGetChildrenForList)
+								   .OnMouseButtonClick(this, &SAdvanceDeletionsTab::OnRowWidgetMouseButtonClicked)
+								   .HeaderRow(ConstructHeaderRow());
 
 	return ConstructedAssetListView.ToSharedRef();
 }
+void SAdvanceDeletionsTab::OnGetChildrenForList(TSharedPtr<FAssetData> AssetData, TArray<TSharedPtr<FAssetData>>& OutChildren)
+{
+	const int32* GroupIndex = DuplicateGroupByRoot.Find(AssetData);
+	if (!GroupIndex)
+	{
+		return;
+	}
+
+	const TArray<TSharedPtr<FAssetData>>& GroupAssets = DuplicateGroups[ *GroupIndex ].Assets;
+	for (int32 AssetIndex = 1; AssetIndex < GroupAssets.Num(); ++AssetIndex)
+	{
+		OutChildren.Add(GroupAssets[ AssetIndex ]);
+	}
+}
 TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvanceDeletionsTab::ConstructComboBox()
 {
 	return SNew(SComboBox<TSharedPtr<FString>>)
@@ -103,60 +261,160 @@ TSharedRef<SComboBox<TSharedPtr<FString>>> SAdvanceDeletionsTab::ConstructComboB
 			[ SAssignNew(ComboDisplayBox, STextBlock)
 				  .Text(FText::FromString(TEXT("List Assets Option"))) ];
 }
+TSharedRef<SHeaderRow> SAdvanceDeletionsTab::ConstructHeaderRow()
+{
+	using namespace AdvancedDeletionWidget;
+
+	return SNew(SHeaderRow)
+		+ SHeaderRow::Column(CheckColumn)
+			  .FixedWidth(24.f)
+			  .DefaultLabel(FText::GetEmpty())
+		+ SHeaderRow::Column(NameColumn)
+			  .FillWidth(.25f)
+			  .DefaultLabel(FText::FromString(TEXT("Name")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, NameColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(ClassColumn)
+			  .FillWidth(.12f)
+			  .DefaultLabel(FText::FromString(TEXT("Class")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, ClassColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(GroupColumn)
+			  .FillWidth(.13f)
+			  .DefaultLabel(FText::FromString(TEXT("Group")))
+		+ SHeaderRow::Column(PathColumn)
+			  .FillWidth(.3f)
+			  .DefaultLabel(FText::FromString(TEXT("Path")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, PathColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(SizeColumn)
+			  .FillWidth(.07f)
+			  .DefaultLabel(FText::FromString(TEXT("Size")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, SizeColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(ModifiedColumn)
+			  .FillWidth(.08f)
+			  .DefaultLabel(FText::FromString(TEXT("Modified")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, ModifiedColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(ReferencersColumn)
+			  .FillWidth(.05f)
+			  .DefaultLabel(FText::FromString(TEXT("Refs")))
+			  .SortMode(this, &SAdvanceDeletionsTab::GetColumnSortMode, ReferencersColumn)
+			  .OnSort(this, &SAdvanceDeletionsTab::OnColumnSortModeChanged)
+		+ SHeaderRow::Column(DeleteColumn)
+			  .FixedWidth(64.f)
+			  .DefaultLabel(FText::GetEmpty());
+}
 TSharedRef<ITableRow> SAdvanceDeletionsTab::OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable)
 {
 	if (!AssetDataToDisplay.IsValid())
 	{
 		return SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable);
 	}
-	const FString DisplayAssetClassName = AssetDataToDisplay->AssetClassPath.GetAssetName().ToString();
-	const FString DisplayAssetPath = AssetDataToDisplay->PackagePath.ToString();
-	const FString DisplayAssetName = AssetDataToDisplay->AssetName.ToString();
-
-	FSlateFontInfo AssetClassNameFort = GetEmbossedTextFont();
-	AssetClassNameFort.Size = 7;
-
-	TSharedRef<STableRow<TSharedPtr<FAssetData>>> ListViewRowWidget =
-		SNew(STableRow<TSharedPtr<FAssetData>>, OwnerTable)
-			.Padding(FMargin(5.f))
-				[ SNew(SHorizontalBox)
-				  // CheckBoxSlot
-				  + SHorizontalBox::Slot()
-						.HAlign(HAlign_Left)
-						.VAlign(VAlign_Center)
-						.FillWidth(.02f)
-							[ ConstructCheckBox(AssetDataToDisplay) ]
-				  // AssetClassName
-				  + SHorizontalBox::Slot()
-						.HAlign(HAlign_Center)
-						.VAlign(VAlign_Fill)
-						.FillWidth(.3f)
-							[ ConstructTextBLock(DisplayAssetClassName, AssetClassNameFort) ]
-				  // AssetName
-				  + SHorizontalBox::Slot()
+
+	return SNew(AdvancedDeletionWidget::SAssetRow, OwnerTable)
+		.OnGenerateCell(this, &SAdvanceDeletionsTab::OnGenerateCellForList, AssetDataToDisplay);
+}
+TSharedRef<SWidget> SAdvanceDeletionsTab::OnGenerateCellForList(const FName& ColumnName, const TSharedRef<ITableRow>& Row, TSharedPtr<FAssetData> AssetDataToDisplay)
+{
+	using namespace AdvancedDeletionWidget;
+
+	if (ColumnName == CheckColumn)
+	{
+		return ConstructCheckBox(AssetDataToDisplay);
+	}
+	if (ColumnName == NameColumn)
+	{
+		// Group expander, indents the copies under the first asset of a group
+		return SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+				  .AutoWidth()
+				  .VAlign(VAlign_Center)
+					  [ SNew(SExpanderArrow, Row) ]
+			+ SHorizontalBox::Slot()
+				  .VAlign(VAlign_Center)
 					  [ SNew(STextBlock)
-							.Text(FText::FromString(DisplayAssetName)) ]
-				  // Asset Path
-				  + SHorizontalBox::Slot()
-						.HAlign(HAlign_Center)
-						.VAlign(VAlign_Fill)
-							[ ConstructTextBLock(DisplayAssetPath, AssetClassNameFort) ]
-				  // ButtonToDeleteDirectly
-				  + SHorizontalBox::Slot()
-						.HAlign(HAlign_Right)
-						.VAlign(VAlign_Fill)
-							[ ConstructDeleteButton(AssetDataToDisplay) ] ];
-
-	return ListViewRowWidget;
+							.Text(FText::FromName(AssetDataToDisplay->AssetName)) ];
+	}
+	if (ColumnName == ClassColumn)
+	{
+		return ConstructTextBLock(FText::FromName(AssetDataToDisplay->AssetClassPath.GetAssetName()), RowTextFont);
+	}
+	if (ColumnName == GroupColumn)
+	{
+		const int32* GroupIndex = DuplicateGroupByRoot.Find(AssetDataToDisplay);
+		if (!GroupIndex)
+		{
+			return SNullWidget::NullWidget;
+		}
+
+		const FAssetDuplicateGroup& Group = DuplicateGroups[ *GroupIndex ];
+		FString DisplayGroupSummary = FString::Printf(TEXT("x%d  %s"), Group.Assets.Num(), *FText::AsMemory(Group.TotalDiskSize).ToString());
+		if (Group.ReclaimableMemory > 0)
+		{
+			DisplayGroupSummary += FString::Printf(TEXT("  (%s reclaimable)"), *FText::AsMemory(Group.ReclaimableMemory).ToString());
+		}
+		return ConstructTextBLock(FText::FromString(DisplayGroupSummary), RowTextFont, FColor::Yellow);
+	}
+	if (ColumnName == PathColumn)
+	{
+		return ConstructTextBLock(FText::FromName(AssetDataToDisplay->PackagePath), RowTextFont);
+	}
+	if (ColumnName == DeleteColumn)
+	{
+		return ConstructDeleteButton(AssetDataToDisplay);
+	}
+
+	// File stats arrive while rows are already on screen, so these cells poll instead of being rebuilt
+	if (ColumnName == SizeColumn)
+	{
+		return SNew(STextBlock)
+			.Text(this, &SAdvanceDeletionsTab::GetAssetFileSizeText, AssetDataToDisplay)
+			.Font(RowTextFont);
+	}
+	if (ColumnName == ModifiedColumn)
+	{
+		return SNew(STextBlock)
+			.Text(this, &SAdvanceDeletionsTab::GetAssetModifiedText, AssetDataToDisplay)
+			.Font(RowTextFont);
+	}
+
+	// Key columns stay empty until the keys are built, the rows are regenerated then
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetDataToDisplay);
+	if (!SortKeys.IsValid() || !StoredIndex || *StoredIndex >= SortKeys->Num())
+	{
+		return SNullWidget::NullWidget;
+	}
+	if (ColumnName == ReferencersColumn)
+	{
+		return ConstructTextBLock(FText::AsNumber(SortKeys->ReferencerCounts[ *StoredIndex ]), RowTextFont);
+	}
+	return SNullWidget::NullWidget;
+}
+EColumnSortMode::Type SAdvanceDeletionsTab::GetColumnSortMode(const FName ColumnId) const
+{
+	return SortColumn == ColumnId ? SortMode : EColumnSortMode::None;
+}
+void SAdvanceDeletionsTab::OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type InSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = InSortMode;
+
+	SortViewAssets();
+	RebuildDisplayedAssets();
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestTreeRefresh();
+	}
 }
 TSharedRef<SCheckBox> SAdvanceDeletionsTab::ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay)
 {
-	TSharedRef<SCheckBox> ConstructedCheckBox = SNew(SCheckBox)
-													.Type(ESlateCheckBoxType::CheckBox)
-													.OnCheckStateChanged(this, &SAdvanceDeletionsTab::OnCheckBoxStateChange, AssetDataToDisplay)
-													.Visibility(EVisibility::Visible);
-	CheckBoxesArray.Add(ConstructedCheckBox);
-	return ConstructedCheckBox;
+	return SNew(SCheckBox)
+		.Type(ESlateCheckBoxType::CheckBox)
+		.IsChecked(this, &SAdvanceDeletionsTab::GetCheckBoxState, AssetDataToDisplay)
+		.OnCheckStateChanged(this, &SAdvanceDeletionsTab::OnCheckBoxStateChange, AssetDataToDisplay)
+		.Visibility(EVisibility::Visible);
 }
 TSharedRef<SCheckBox> SAdvanceDeletionsTab::ConstructGlobalCheckBox()
 {
@@ -165,10 +423,22 @@ TSharedRef<SCheckBox> SAdvanceDeletionsTab::ConstructGlobalCheckBox()
 		.OnCheckStateChanged(this, &SAdvanceDeletionsTab::OnGlobalCheckBoxStateChange)
 		.Visibility(EVisibility::Visible);
 }
-TSharedRef<STextBlock> SAdvanceDeletionsTab::ConstructTextBLock(const FString& TextContent, const FSlateFontInfo& FontToUse, const FColor& ColorToUse)
+TSharedRef<SButton> SAdvanceDeletionsTab::ConstructInvertSelectionButton()
+{
+	return SNew(SButton)
+		.Text(FText::FromString("Invert Selection"))
+		.OnClicked(this, &SAdvanceDeletionsTab::OnInvertSelectionButtonClicked);
+}
+TSharedRef<SWidget> SAdvanceDeletionsTab::ConstructSearchBox()
+{
+	return SNew(SSearchBox)
+		.HintText(FText::FromString(TEXT("Search name, path, class or tag")))
+		.OnTextChanged(this, &SAdvanceDeletionsTab::OnSearchTextChanged);
+}
+TSharedRef<STextBlock> SAdvanceDeletionsTab::ConstructTextBLock(const FText& TextContent, const FSlateFontInfo& FontToUse, const FColor& ColorToUse)
 {
 	return SNew(STextBlock)
-		.Text(FText::FromString(TextContent))
+		.Text(TextContent)
 		.Font(FontToUse)
 		.ColorAndOpacity(ColorToUse);
 }
@@ -182,7 +452,7 @@ TSharedRef<SButton> SAdvanceDeletionsTab::ConstructDeleteButton(const TSharedPtr
 TSharedRef<SButton> SAdvanceDeletionsTab::ConstructDeleteSelectedButton()
 {
 	return SNew(SButton)
-		.Text(FText::FromString("Delete Selected"))
+		.Text(this, &SAdvanceDeletionsTab::GetDeleteSelectedButtonText)
 		.OnClicked(this, &SAdvanceDeletionsTab::OnDeleteSelectedButtonClicked);
 }
 TSharedRef<SWidget> SAdvanceDeletionsTab::OnGenerateComboContent(TSharedPtr<FString> SourceItem)
@@ -192,25 +462,242 @@ TSharedRef<SWidget> SAdvanceDeletionsTab::OnGenerateComboContent(TSharedPtr<FStr
 void SAdvanceDeletionsTab::OnComboSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo)
 {
 	ComboDisplayBox->SetText(FText::FromString(*SelectedOption.Get()));
+	SelectedListOption = SelectedOption;
 
 	FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
 
+	DuplicateGroups.Empty();
+	DuplicateGroupByRoot.Empty();
+
 	// Pass data to module filter
-	if (*SelectedOption.Get() == ListALL)
+	if (const FCachedListView* CachedView = CachedListViews.Find(*SelectedOption.Get()))
+	{
+		ViewAssetsData = CachedView->ViewAssetsData;
+		DuplicateGroups = CachedView->DuplicateGroups;
+	}
+	else if (*SelectedOption.Get() == ListALL)
 	{
-		DisplayedAssetsData = StoredAssetsData;
+		ViewAssetsData = StoredAssetsData;
 	}
 	else if (*SelectedOption.Get() == ListUnused)
 	{
-		EditorExtensionsModule.GetUnusedAssetData(StoredAssetsData, DisplayedAssetsData);
+		ViewAssetsData.Empty();
+		EditorExtensionsModule.GetUnusedAssetData(StoredAssetsData, ViewAssetsData);
+		CacheListView(*SelectedOption.Get());
 	}
 	else if (*SelectedOption.Get() == ListDuplicated)
 	{
-		EditorExtensionsModule.GetDuplicatedAssetData(StoredAssetsData, DisplayedAssetsData);
+		ViewAssetsData.Empty();
+		EditorExtensionsModule.GetDuplicatedAssetGroups(StoredAssetsData, DuplicateGroups);
+		CacheListView(*SelectedOption.Get());
+	}
+	else if (*SelectedOption.Get() == ListUnreachable)
+	{
+		ViewAssetsData.Empty();
+		EditorExtensionsModule.GetUnreachableAssetData(StoredAssetsData, ViewAssetsData);
+		CacheListView(*SelectedOption.Get());
+	}
+	else if (AdvancedDeletionWidget::IsHashedListOption(SelectedOption))
+	{
+		// Filled in when hashing finishes, unless another option was picked meanwhile
+		ViewAssetsData.Empty();
+
+		// Hashing a partial list would have to be redone, and the module runs one scan at a time
+		if (AssetStream.IsValid() || EditorExtensionsModule.IsCleanupScanRunning())
+		{
+			if (!bHashedViewQueued)
+			{
+				bHashedViewQueued = true;
+				RegisterActiveTimer(AdvancedDeletionWidget::QueuedHashedViewPollInterval, FWidgetActiveTimerDelegate::CreateSP(this, &SAdvanceDeletionsTab::PollQueuedHashedView));
+			}
+		}
+		else
+		{
+			LaunchHashedView(SelectedOption);
+		}
 	}
 
+	SortViewAssets();
+	RebuildDisplayedAssets();
 	RefreshAssetListView();
 }
+void SAdvanceDeletionsTab::LaunchHashedView(const TSharedPtr<FString>& SelectedOption)
+{
+	FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
+
+	TWeakPtr<SAdvanceDeletionsTab> WeakTab = StaticCastSharedRef<SAdvanceDeletionsTab>(AsShared());
+	auto OnGroupsFound = [WeakTab, SelectedOption, CacheGeneration = ListViewCacheGeneration](TArray<FAssetDuplicateGroup>&& FoundGroups)
+	{
+		const TSharedPtr<SAdvanceDeletionsTab> Tab = WeakTab.Pin();
+		if (!Tab.IsValid())
+		{
+			return;
+		}
+
+		// Kept for later even if another option was picked meanwhile, unless the assets changed while hashing
+		if (Tab->ListViewCacheGeneration == CacheGeneration)
+		{
+			Tab->CachedListViews.Add(*SelectedOption.Get(), { {}, FoundGroups });
+		}
+		if (Tab->SelectedListOption == SelectedOption)
+		{
+			Tab->SetDuplicateGroups(MoveTemp(FoundGroups));
+			Tab->RefreshAssetListView();
+		}
+	};
+
+	if (*SelectedOption.Get() == ListIdenticalContent)
+	{
+		EditorExtensionsModule.FindContentDuplicatedAssetGroups(StoredAssetsData, MoveTemp(OnGroupsFound));
+	}
+	else if (*SelectedOption.Get() == ListSimilarTextures)
+	{
+		EditorExtensionsModule.FindSimilarTextureGroups(StoredAssetsData, MoveTemp(OnGroupsFound));
+	}
+	else
+	{
+		EditorExtensionsModule.FindIdenticalMeshGroups(StoredAssetsData, MoveTemp(OnGroupsFound));
+	}
+}
+EActiveTimerReturnType SAdvanceDeletionsTab::PollQueuedHashedView(const double InCurrentTime, const float InDeltaTime)
+{
+	if (!AdvancedDeletionWidget::IsHashedListOption(SelectedListOption))
+	{
+		bHashedViewQueued = false;
+		return EActiveTimerReturnType::Stop;
+	}
+
+	const FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
+	if (AssetStream.IsValid() || EditorExtensionsModule.IsCleanupScanRunning())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	// Whichever hashed view is picked by now, from the cache if another scan already produced it
+	bHashedViewQueued = false;
+	OnComboSelectionChanged(SelectedListOption, ESelectInfo::Direct);
+	return EActiveTimerReturnType::Stop;
+}
+EActiveTimerReturnType SAdvanceDeletionsTab::PumpAssetStream(const double InCurrentTime, const float InDeltaTime)
+{
+	TArray<TSharedPtr<FAssetData>> NewAssetsData;
+	AssetStream->Dequeue(NewAssetsData, AdvancedDeletionWidget::StreamedAssetsPerFrame);
+	if (!NewAssetsData.IsEmpty())
+	{
+		AppendStoredAssets(MoveTemp(NewAssetsData));
+	}
+
+	if (!AssetStream->IsFinished())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	OnAssetStreamFinished();
+	return EActiveTimerReturnType::Stop;
+}
+void SAdvanceDeletionsTab::AppendStoredAssets(TArray<TSharedPtr<FAssetData>>&& NewAssetsData)
+{
+	InvalidateListViewCache();
+
+	// New assets take new slots at the end, nothing already stored moves and the selection is kept
+	const int32 FirstNewIndex = StoredAssetsData.Num();
+	const int32 NumNewAssets = NewAssetsData.Num();
+	StoredAssetsData.Append(MoveTemp(NewAssetsData));
+
+	SelectedAssetBits.Add(false, NumNewAssets);
+	AssetModifiedTicks.AddZeroed(NumNewAssets);
+	AssetFileSizes.Reserve(StoredAssetsData.Num());
+	if (TextFilterResult.IsValid())
+	{
+		TextFilterMatchBits.Add(false, NumNewAssets);
+	}
+
+	// Other views are worked out over the whole list once it is complete
+	const bool bListingAllAssets = IsListingAllAssets();
+	for (int32 StoredIndex = FirstNewIndex; StoredIndex < StoredAssetsData.Num(); ++StoredIndex)
+	{
+		const TSharedPtr<FAssetData>& AssetData = StoredAssetsData[ StoredIndex ];
+		StoredAssetIndices.Add(AssetData, StoredIndex);
+		AssetFileSizes.Add(INDEX_NONE);
+
+		if (TextFilterResult.IsValid())
+		{
+			TextFilterMatchBits[ StoredIndex ] = FAssetTextFilterIndex::MatchesTerms(*AssetData, TextFilterResult->Terms);
+		}
+		if (bListingAllAssets)
+		{
+			ViewAssetsData.Add(AssetData);
+			if (PassesTextFilter(AssetData))
+			{
+				DisplayedAssetsData.Add(AssetData);
+			}
+		}
+	}
+
+	// Rebuilt each time the list doubles, so the assets matched one by one stay a fraction of the list
+	if (StoredAssetsData.Num() > FMath::Max(2 * NumTextIndexedAssets, AdvancedDeletionWidget::StreamedAssetsPerTextIndexBuild))
+	{
+		BuildTextFilterIndex();
+	}
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestTreeRefresh();
+	}
+}
+void SAdvanceDeletionsTab::OnAssetStreamFinished()
+{
+	const int32 NumExcludedAssets = AssetStream->GetNumExcludedAssets();
+	if (NumExcludedAssets > 0)
+	{
+		DebugHelper::ShowNotifyInfo(FString::Printf(TEXT("Skipped %d assets in excluded folders"), NumExcludedAssets));
+	}
+	AssetStream.Reset();
+
+	// Everything that needs the whole list is built once, now that it is complete
+	BuildTextFilterIndex();
+	BuildSortKeys();
+	StatAssetFiles();
+
+	if (!IsListingAllAssets())
+	{
+		OnComboSelectionChanged(SelectedListOption, ESelectInfo::Direct);
+	}
+}
+FText SAdvanceDeletionsTab::GetAssetCountText() const
+{
+	if (!AssetStream.IsValid())
+	{
+		return FText::FromString(FString::Printf(TEXT("%d assets"), StoredAssetsData.Num()));
+	}
+
+	const FAssetScanProgress& Progress = AssetStream->GetProgress();
+	return FText::FromString(FString::Printf(TEXT("Listing... %d assets (%d / %d folders)"), StoredAssetsData.Num(), Progress.GetCompleted(), Progress.GetTotal()));
+}
+bool SAdvanceDeletionsTab::IsListingAllAssets() const
+{
+	return !SelectedListOption.IsValid() || *SelectedListOption.Get() == ListALL;
+}
+void SAdvanceDeletionsTab::CacheListView(const FString& ListOption)
+{
+	FCachedListView& CachedView = CachedListViews.Add(ListOption);
+	CachedView.ViewAssetsData = ViewAssetsData;
+	CachedView.DuplicateGroups = DuplicateGroups;
+}
+void SAdvanceDeletionsTab::InvalidateListViewCache()
+{
+	// The listed view stays as it is, only the next switch recomputes
+	CachedListViews.Reset();
+	++ListViewCacheGeneration;
+}
+void SAdvanceDeletionsTab::OnAssetRegistryChanged(const FAssetData& AssetData)
+{
+	InvalidateListViewCache();
+}
+void SAdvanceDeletionsTab::OnAssetRegistryRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	InvalidateListViewCache();
+}
 void SAdvanceDeletionsTab::OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData)
 {
 	FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
@@ -221,13 +708,10 @@ void SAdvanceDeletionsTab::OnCheckBoxStateChange(ECheckBoxState NewState, TShare
 	switch (NewState)
 	{
 		case ECheckBoxState::Unchecked:
-			if (SelectedAssetData.Contains(AssetData))
-			{
-				SelectedAssetData.Remove(AssetData);
-			}
+			SetAssetSelected(AssetData, false);
 			break;
 		case ECheckBoxState::Checked:
-			SelectedAssetData.AddUnique(AssetData);
+			SetAssetSelected(AssetData, true);
 			break;
 		case ECheckBoxState::Undetermined:
 			break;
@@ -235,32 +719,24 @@ void SAdvanceDeletionsTab::OnCheckBoxStateChange(ECheckBoxState NewState, TShare
 			break;
 	}
 }
+ECheckBoxState SAdvanceDeletionsTab::GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const
+{
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+	return StoredIndex && SelectedAssetBits[ *StoredIndex ] ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+}
 void SAdvanceDeletionsTab::OnGlobalCheckBoxStateChange(ECheckBoxState NewState)
 {
-	if (CheckBoxesArray.Num() == 0)
-	{
-		return;
-	}
-
 	switch (NewState)
 	{
 		case ECheckBoxState::Unchecked:
-			for (const TSharedRef<SCheckBox>& CheckBox : CheckBoxesArray)
-			{
-				if (CheckBox->IsChecked())
-				{
-					CheckBox->ToggleCheckedState();
-				}
-			}
+			ClearSelection();
 			break;
 		case ECheckBoxState::Checked:
-			for (const TSharedRef<SCheckBox>& CheckBox : CheckBoxesArray)
+			// Everything listed, including collapsed group members and rows never scrolled into view
+			ForEachListedAsset([this](const TSharedPtr<FAssetData>& AssetData)
 			{
-				if (!CheckBox->IsChecked())
-				{
-					CheckBox->ToggleCheckedState();
-				}
-			}
+				SetAssetSelected(AssetData, true);
+			});
 			break;
 		case ECheckBoxState::Undetermined:
 			break;
@@ -268,6 +744,33 @@ void SAdvanceDeletionsTab::OnGlobalCheckBoxStateChange(ECheckBoxState NewState)
 			break;
 	}
 }
+FReply SAdvanceDeletionsTab::OnInvertSelectionButtonClicked()
+{
+	// Assets hidden by the current view are not listed, so they stay unselected
+	const TBitArray<> ListedAssetBits = GetListedAssetBits();
+
+	SelectedAssetBits = TBitArray<>::BitwiseXOR(SelectedAssetBits, ListedAssetBits, EBitwiseOperatorFlags::MaxSize);
+	SelectedAssetBits.CombineWithBitwiseAND(ListedAssetBits, EBitwiseOperatorFlags::MaintainSize);
+	RecountSelection();
+	return FReply::Handled();
+}
+FText SAdvanceDeletionsTab::GetDeleteSelectedButtonText() const
+{
+	if (NumSelectedAssets == 0)
+	{
+		return FText::FromString(TEXT("Delete Selected"));
+	}
+	return FText::FromString(FString::Printf(TEXT("Delete Selected (%d)"), NumSelectedAssets));
+}
+FText SAdvanceDeletionsTab::GetReclaimableText() const
+{
+	FString ReclaimableText = TEXT("Reclaimable: ") + FText::AsMemory(SelectedFileSize).ToString();
+	if (FileStatProgress.IsValid() && FileStatProgress->GetCompleted() < FileStatProgress->GetTotal())
+	{
+		ReclaimableText += FString::Printf(TEXT("  (sizing %d / %d)"), FileStatProgress->GetCompleted(), FileStatProgress->GetTotal());
+	}
+	return FText::FromString(ReclaimableText);
+}
 FReply SAdvanceDeletionsTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> AssetData)
 {
 	FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
@@ -275,27 +778,21 @@ FReply SAdvanceDeletionsTab::OnDeleteButtonClicked(TSharedPtr<FAssetData> AssetD
 	// Refresh List
 	if (EditorExtensionsModule.DeleteAsset(*AssetData.Get()))
 	{
-		// Update List Store Data
-		if (StoredAssetsData.Contains(AssetData))
-		{
-			StoredAssetsData.Remove(AssetData);
-		}
-		if (DisplayedAssetsData.Contains(AssetData))
-		{
-			DisplayedAssetsData.Remove(AssetData);
-		}
-		RefreshAssetListView();
+		RemoveDeletedAssets({ AssetData });
 	}
 	return FReply::Handled();
 }
 FReply SAdvanceDeletionsTab::OnDeleteSelectedButtonClicked()
 {
+	const TArray<TSharedPtr<FAssetData>> SelectedAssetData = GetSelectedAssetData();
 	if (SelectedAssetData.IsEmpty())
 	{
 		return FReply::Handled();
 	}
 
+	// ObjectTools takes the asset data by value, this is the only copy made
 	TArray<FAssetData> AssetsDataToDelete;
+	AssetsDataToDelete.Reserve(SelectedAssetData.Num());
 	for (const TSharedPtr<FAssetData>& Data : SelectedAssetData)
 	{
 		AssetsDataToDelete.Add(*Data.Get());
@@ -304,19 +801,587 @@ FReply SAdvanceDeletionsTab::OnDeleteSelectedButtonClicked()
 	FEditorExtensionsModule& EditorExtensionsModule = FModuleManager::LoadModuleChecked<FEditorExtensionsModule>(TEXT("EditorExtensions"));
 	if (EditorExtensionsModule.DeleteAssets(AssetsDataToDelete))
 	{
-		for (const TSharedPtr<FAssetData>& Data : SelectedAssetData)
+		RemoveDeletedAssets(SelectedAssetData);
+	}
+
+	return FReply::Handled();
+}
+void SAdvanceDeletionsTab::SetDuplicateGroups(TArray<FAssetDuplicateGroup>&& InDuplicateGroups)
+{
+	DuplicateGroups = MoveTemp(InDuplicateGroups);
+	SortViewAssets();
+	RebuildDisplayedAssets();
+}
+void SAdvanceDeletionsTab::RemoveDeletedAssets(const TArray<TSharedPtr<FAssetData>>& AttemptedAssetData)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Batches can be cancelled and single assets refused, only assets gone from the registry leave the list
+	TBitArray<> RemovedAssetBits(false, StoredAssetsData.Num());
+	bool bAnyRemoved = false;
+	for (const TSharedPtr<FAssetData>& AssetData : AttemptedAssetData)
+	{
+		const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+		if (StoredIndex && !AssetRegistry.GetAssetByObjectPath(AssetData->GetSoftObjectPath(), true).IsValid())
 		{
-			if (StoredAssetsData.Contains(Data))
+			RemovedAssetBits[ *StoredIndex ] = true;
+			bAnyRemoved = true;
+		}
+	}
+
+	if (bAnyRemoved)
+	{
+		RemoveStoredAssets(RemovedAssetBits);
+		RebuildDisplayedAssets();
+		RefreshAssetListView();
+	}
+}
+void SAdvanceDeletionsTab::RemoveStoredAssets(const TBitArray<>& RemovedAssetBits)
+{
+	// Lookups go through the slots as they were, so the view and groups are trimmed before the slots move
+	ViewAssetsData.RemoveAll([this, &RemovedAssetBits](const TSharedPtr<FAssetData>& AssetData)
+	{
+		const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+		return StoredIndex && RemovedAssetBits[ *StoredIndex ];
+	});
+	RemoveDeletedFromDuplicateGroups(RemovedAssetBits);
+
+	InvalidateListViewCache();
+
+	// One compaction pass over every per-slot array. Kept slots stay in order, so a sorted list stays sorted.
+	const bool bHasTextFilterMatches = !TextFilterMatchBits.IsEmpty();
+	int32 NumKept = 0;
+	for (int32 StoredIndex = 0; StoredIndex < StoredAssetsData.Num(); ++StoredIndex)
+	{
+		if (RemovedAssetBits[ StoredIndex ])
+		{
+			StoredAssetIndices.Remove(StoredAssetsData[ StoredIndex ]);
+			continue;
+		}
+
+		if (NumKept != StoredIndex)
+		{
+			StoredAssetIndices.FindChecked(StoredAssetsData[ StoredIndex ]) = NumKept;
+			StoredAssetsData[ NumKept ] = MoveTemp(StoredAssetsData[ StoredIndex ]);
+			AssetFileSizes[ NumKept ] = AssetFileSizes[ StoredIndex ];
+			AssetModifiedTicks[ NumKept ] = AssetModifiedTicks[ StoredIndex ];
+			SelectedAssetBits[ NumKept ] = SelectedAssetBits[ StoredIndex ];
+			if (bHasTextFilterMatches)
 			{
-				StoredAssetsData.Remove(Data);
+				TextFilterMatchBits[ NumKept ] = TextFilterMatchBits[ StoredIndex ];
 			}
-			if (DisplayedAssetsData.Contains(Data))
+		}
+		++NumKept;
+	}
+
+	const int32 NumRemoved = StoredAssetsData.Num() - NumKept;
+	StoredAssetsData.SetNum(NumKept);
+	AssetFileSizes.SetNum(NumKept);
+	AssetModifiedTicks.SetNum(NumKept);
+	SelectedAssetBits.RemoveAt(NumKept, NumRemoved);
+	if (bHasTextFilterMatches)
+	{
+		TextFilterMatchBits.RemoveAt(NumKept, NumRemoved);
+	}
+	RecountSelection();
+
+	if (SortKeys.IsValid())
+	{
+		TSharedRef<FAssetSortKeys> CompactedSortKeys = MakeShared<FAssetSortKeys>(*SortKeys);
+		CompactedSortKeys->RemoveSlots(RemovedAssetBits);
+		SortKeys = CompactedSortKeys;
+	}
+
+	// Referencer counts of the remaining assets can drop, they are refreshed in the background meanwhile
+	BuildSortKeys();
+
+	// Batches already posted by a running scan still address the old slots, restarting cancels them all
+	if (FileStatProgress.IsValid())
+	{
+		StatAssetFiles();
+	}
+}
+void SAdvanceDeletionsTab::RemoveDeletedFromDuplicateGroups(const TBitArray<>& RemovedAssetBits)
+{
+	if (DuplicateGroups.IsEmpty())
+	{
+		return;
+	}
+
+	const FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+
+	for (FAssetDuplicateGroup& Group : DuplicateGroups)
+	{
+		Group.Assets.RemoveAll([&](const TSharedPtr<FAssetData>& Data)
+		{
+			const int32* StoredIndex = StoredAssetIndices.Find(Data);
+			if (!StoredIndex || !RemovedAssetBits[ *StoredIndex ])
 			{
-				DisplayedAssetsData.Remove(Data);
+				return false;
+			}
+
+			const TOptional<FAssetPackageData> PackageData = AssetRegistryModule.Get().GetAssetPackageDataCopy(Data->PackageName);
+			Group.TotalDiskSize -= PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+			return true;
+		});
+	}
+
+	// A group down to one asset has no duplicates left
+	DuplicateGroups.RemoveAll([](const FAssetDuplicateGroup& Group)
+	{
+		return Group.Assets.Num() < 2;
+	});
+}
+void SAdvanceDeletionsTab::RebuildDisplayedAssets()
+{
+	DisplayedAssetsData.Reset();
+	DuplicateGroupByRoot.Empty(DuplicateGroups.Num());
+
+	if (DuplicateGroups.IsEmpty())
+	{
+		for (const TSharedPtr<FAssetData>& AssetData : ViewAssetsData)
+		{
+			if (PassesTextFilter(AssetData))
+			{
+				DisplayedAssetsData.Add(AssetData);
 			}
 		}
-		RefreshAssetListView();
+		return;
 	}
 
-	return FReply::Handled();
+	// A group stays listed whole while any of its assets matches the text filter
+	for (int32 GroupIndex = 0; GroupIndex < DuplicateGroups.Num(); ++GroupIndex)
+	{
+		const TArray<TSharedPtr<FAssetData>>& GroupAssets = DuplicateGroups[ GroupIndex ].Assets;
+		DuplicateGroupByRoot.Add(GroupAssets[ 0 ], GroupIndex);
+
+		if (GroupAssets.ContainsByPredicate([this](const TSharedPtr<FAssetData>& AssetData) { return PassesTextFilter(AssetData); }))
+		{
+			DisplayedAssetsData.Add(GroupAssets[ 0 ]);
+		}
+	}
+}
+void SAdvanceDeletionsTab::OnSearchTextChanged(const FText& InSearchText)
+{
+	TextFilterQuery = InSearchText.ToString().TrimStartAndEnd();
+	LaunchTextFilterQuery();
+}
+void SAdvanceDeletionsTab::BuildTextFilterIndex()
+{
+	// The current index keeps answering queries until this one is ready
+	const uint32 Generation = ++TextFilterIndexGeneration;
+	NumTextIndexedAssets = StoredAssetsData.Num();
+
+	TWeakPtr<SAdvanceDeletionsTab> WeakTab = StaticCastSharedRef<SAdvanceDeletionsTab>(AsShared());
+	Async(EAsyncExecution::ThreadPool, [WeakTab, Generation, AssetsData = StoredAssetsData]()
+	{
+		TSharedRef<FAssetTextFilterIndex> Index = MakeShared<FAssetTextFilterIndex>();
+		Index->Build(AssetsData);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTab, Generation, Index]()
+		{
+			// Builds can finish out of order, an older index never replaces a newer one
+			const TSharedPtr<SAdvanceDeletionsTab> Tab = WeakTab.Pin();
+			if (Tab.IsValid() && Generation > Tab->AppliedTextFilterIndexGeneration)
+			{
+				Tab->AppliedTextFilterIndexGeneration = Generation;
+				Tab->TextFilterIndex = Index;
+				Tab->LaunchTextFilterQuery();
+			}
+		});
+	});
+}
+void SAdvanceDeletionsTab::LaunchTextFilterQuery()
+{
+	const uint32 Generation = ++TextFilterGeneration;
+
+	if (TextFilterQuery.IsEmpty())
+	{
+		if (TextFilterResult.IsValid())
+		{
+			TextFilterResult.Reset();
+			RefreshTextFilterMatches();
+			RebuildDisplayedAssets();
+			if (ConstructedAssetListView.IsValid())
+			{
+				ConstructedAssetListView->RequestTreeRefresh();
+			}
+		}
+		return;
+	}
+
+	// Queried again once the index is built
+	if (!TextFilterIndex.IsValid())
+	{
+		return;
+	}
+
+	TWeakPtr<SAdvanceDeletionsTab> WeakTab = StaticCastSharedRef<SAdvanceDeletionsTab>(AsShared());
+	Async(EAsyncExecution::ThreadPool, [WeakTab, Generation, Index = TextFilterIndex.ToSharedRef(), PreviousResult = TextFilterResult, Query = TextFilterQuery]()
+	{
+		TSharedRef<FAssetTextFilterResult> Result = MakeShared<FAssetTextFilterResult>();
+		Index->Query(Query, *Result, PreviousResult.Get());
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTab, Generation, Result]()
+		{
+			const TSharedPtr<SAdvanceDeletionsTab> Tab = WeakTab.Pin();
+			if (Tab.IsValid() && Tab->TextFilterGeneration == Generation)
+			{
+				Tab->ApplyTextFilterResult(Result);
+			}
+		});
+	});
+}
+void SAdvanceDeletionsTab::ApplyTextFilterResult(const TSharedRef<const FAssetTextFilterResult>& Result)
+{
+	TextFilterResult = Result;
+	RefreshTextFilterMatches();
+	RebuildDisplayedAssets();
+
+	// Hidden assets are never deleted by Delete Selected
+	SelectedAssetBits.CombineWithBitwiseAND(GetListedAssetBits(), EBitwiseOperatorFlags::MaintainSize);
+	RecountSelection();
+
+	if (ConstructedAssetListView.IsValid())
+	{
+		ConstructedAssetListView->RequestTreeRefresh();
+	}
+}
+void SAdvanceDeletionsTab::RefreshTextFilterMatches()
+{
+	if (!TextFilterResult.IsValid() || !TextFilterIndex.IsValid())
+	{
+		TextFilterMatchBits.Empty();
+		return;
+	}
+
+	// Index entries map to stored slots through the asset, deleted assets simply drop out
+	TextFilterMatchBits.Init(false, StoredAssetsData.Num());
+	for (const int32 EntryIndex : TextFilterResult->MatchedEntries)
+	{
+		if (const int32* StoredIndex = StoredAssetIndices.Find(TextFilterIndex->GetAsset(EntryIndex)))
+		{
+			TextFilterMatchBits[ *StoredIndex ] = true;
+		}
+	}
+
+	for (int32 StoredIndex = GetFirstUnindexedSlot(); StoredIndex < StoredAssetsData.Num(); ++StoredIndex)
+	{
+		TextFilterMatchBits[ StoredIndex ] = FAssetTextFilterIndex::MatchesTerms(*StoredAssetsData[ StoredIndex ], TextFilterResult->Terms);
+	}
+}
+int32 SAdvanceDeletionsTab::GetFirstUnindexedSlot() const
+{
+	// Assets are only ever appended and removals keep the order, so whatever follows the last indexed asset still
+	// stored was appended after the index was built
+	for (int32 EntryIndex = TextFilterIndex->Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		if (const int32* StoredIndex = StoredAssetIndices.Find(TextFilterIndex->GetAsset(EntryIndex)))
+		{
+			return *StoredIndex + 1;
+		}
+	}
+	return 0;
+}
+bool SAdvanceDeletionsTab::PassesTextFilter(const TSharedPtr<FAssetData>& AssetData) const
+{
+	if (!TextFilterResult.IsValid())
+	{
+		return true;
+	}
+
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+	return StoredIndex && TextFilterMatchBits[ *StoredIndex ];
+}
+void SAdvanceDeletionsTab::RebuildStoredAssetIndices()
+{
+	StoredAssetIndices.Empty(StoredAssetsData.Num());
+	for (int32 StoredIndex = 0; StoredIndex < StoredAssetsData.Num(); ++StoredIndex)
+	{
+		StoredAssetIndices.Add(StoredAssetsData[ StoredIndex ], StoredIndex);
+	}
+	ClearSelection();
+	RefreshTextFilterMatches();
+
+	// Slots were reassigned, keys built for the old ones would sort the wrong assets
+	SortKeys.Reset();
+	BuildSortKeys();
+	StatAssetFiles();
+}
+void SAdvanceDeletionsTab::ClearSelection()
+{
+	SelectedAssetBits.Init(false, StoredAssetsData.Num());
+	NumSelectedAssets = 0;
+	SelectedFileSize = 0;
+}
+void SAdvanceDeletionsTab::RecountSelection()
+{
+	NumSelectedAssets = 0;
+	SelectedFileSize = 0;
+	for (TConstSetBitIterator<> It(SelectedAssetBits); It; ++It)
+	{
+		++NumSelectedAssets;
+		SelectedFileSize += FMath::Max<int64>(AssetFileSizes[ It.GetIndex() ], 0);
+	}
+}
+void SAdvanceDeletionsTab::SetAssetSelected(const TSharedPtr<FAssetData>& AssetData, const bool bSelected)
+{
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+	if (!StoredIndex || SelectedAssetBits[ *StoredIndex ] == bSelected)
+	{
+		return;
+	}
+
+	SelectedAssetBits[ *StoredIndex ] = bSelected;
+	NumSelectedAssets += bSelected ? 1 : -1;
+	SelectedFileSize += (bSelected ? 1 : -1) * FMath::Max<int64>(AssetFileSizes[ *StoredIndex ], 0);
+}
+void SAdvanceDeletionsTab::ForEachListedAsset(TFunctionRef<void(const TSharedPtr<FAssetData>&)> Callback) const
+{
+	for (const TSharedPtr<FAssetData>& AssetData : DisplayedAssetsData)
+	{
+		const int32* GroupIndex = DuplicateGroupByRoot.Find(AssetData);
+		if (!GroupIndex)
+		{
+			Callback(AssetData);
+			continue;
+		}
+
+		for (const TSharedPtr<FAssetData>& GroupAssetData : DuplicateGroups[ *GroupIndex ].Assets)
+		{
+			Callback(GroupAssetData);
+		}
+	}
+}
+TArray<TSharedPtr<FAssetData>> SAdvanceDeletionsTab::GetSelectedAssetData() const
+{
+	TArray<TSharedPtr<FAssetData>> SelectedAssetData;
+	SelectedAssetData.Reserve(NumSelectedAssets);
+	for (TConstSetBitIterator<> It(SelectedAssetBits); It; ++It)
+	{
+		SelectedAssetData.Add(StoredAssetsData[ It.GetIndex() ]);
+	}
+	return SelectedAssetData;
+}
+TBitArray<> SAdvanceDeletionsTab::GetListedAssetBits() const
+{
+	TBitArray<> ListedAssetBits(false, StoredAssetsData.Num());
+	ForEachListedAsset([this, &ListedAssetBits](const TSharedPtr<FAssetData>& AssetData)
+	{
+		if (const int32* StoredIndex = StoredAssetIndices.Find(AssetData))
+		{
+			ListedAssetBits[ *StoredIndex ] = true;
+		}
+	});
+	return ListedAssetBits;
+}
+void SAdvanceDeletionsTab::BuildSortKeys()
+{
+	// Keys already in place stay in use until the new ones arrive
+	const uint32 Generation = ++SortKeysGeneration;
+
+	TWeakPtr<SAdvanceDeletionsTab> WeakTab = StaticCastSharedRef<SAdvanceDeletionsTab>(AsShared());
+	Async(EAsyncExecution::ThreadPool, [WeakTab, Generation, AssetsData = StoredAssetsData]()
+	{
+		TSharedRef<FAssetSortKeys> Keys = MakeShared<FAssetSortKeys>();
+		Keys->Build(AssetsData);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakTab, Generation, Keys]()
+		{
+			const TSharedPtr<SAdvanceDeletionsTab> Tab = WeakTab.Pin();
+			if (!Tab.IsValid() || Tab->SortKeysGeneration != Generation)
+			{
+				return;
+			}
+
+			Tab->SortKeys = Keys;
+			Tab->SortViewAssets();
+			Tab->RebuildDisplayedAssets();
+			if (Tab->ConstructedAssetListView.IsValid())
+			{
+				Tab->ConstructedAssetListView->RebuildList();
+			}
+		});
+	});
+}
+void SAdvanceDeletionsTab::SortViewAssets()
+{
+	using namespace AdvancedDeletionWidget;
+
+	if (SortMode == EColumnSortMode::None)
+	{
+		return;
+	}
+
+	// Assets become stored slots once, after that every comparison is between two integers
+	TArray<int32> SortedSlots;
+	if (DuplicateGroups.IsEmpty())
+	{
+		SortedSlots.Reserve(ViewAssetsData.Num());
+		for (const TSharedPtr<FAssetData>& AssetData : ViewAssetsData)
+		{
+			SortedSlots.Add(StoredAssetIndices.FindChecked(AssetData));
+		}
+	}
+	else
+	{
+		// Groups are ordered by the asset standing for them
+		SortedSlots.Reserve(DuplicateGroups.Num());
+		for (const FAssetDuplicateGroup& Group : DuplicateGroups)
+		{
+			// Groups found by a scan that overlapped a deletion can still name removed assets
+			const int32* StoredIndex = StoredAssetIndices.Find(Group.Assets[ 0 ]);
+			if (!StoredIndex)
+			{
+				return;
+			}
+			SortedSlots.Add(*StoredIndex);
+		}
+	}
+
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	auto SortSlotsBy = [&SortedSlots, bAscending](const auto& Keys)
+	{
+		// Slot order breaks ties, which keeps the sort stable without a stable sort
+		SortedSlots.Sort([&Keys, bAscending](const int32 A, const int32 B)
+		{
+			if (Keys[ A ] != Keys[ B ])
+			{
+				return bAscending ? Keys[ A ] < Keys[ B ] : Keys[ B ] < Keys[ A ];
+			}
+			return A < B;
+		});
+	};
+
+	if (SortColumn == SizeColumn)
+	{
+		SortSlotsBy(AssetFileSizes);
+	}
+	else if (SortColumn == ModifiedColumn)
+	{
+		SortSlotsBy(AssetModifiedTicks);
+	}
+	else if (!SortKeys.IsValid() || SortKeys->Num() != StoredAssetsData.Num())
+	{
+		return;
+	}
+	else if (SortColumn == NameColumn)
+	{
+		SortSlotsBy(SortKeys->NameRanks);
+	}
+	else if (SortColumn == ClassColumn)
+	{
+		SortSlotsBy(SortKeys->ClassRanks);
+	}
+	else if (SortColumn == PathColumn)
+	{
+		SortSlotsBy(SortKeys->PathRanks);
+	}
+	else if (SortColumn == ReferencersColumn)
+	{
+		SortSlotsBy(SortKeys->ReferencerCounts);
+	}
+	else
+	{
+		return;
+	}
+
+	if (DuplicateGroups.IsEmpty())
+	{
+		for (int32 ViewIndex = 0; ViewIndex < SortedSlots.Num(); ++ViewIndex)
+		{
+			ViewAssetsData[ ViewIndex ] = StoredAssetsData[ SortedSlots[ ViewIndex ] ];
+		}
+		return;
+	}
+
+	TMap<int32, int32> GroupBySlot;
+	for (int32 GroupIndex = 0; GroupIndex < DuplicateGroups.Num(); ++GroupIndex)
+	{
+		GroupBySlot.Add(SortedSlots[ GroupIndex ], GroupIndex);
+	}
+
+	TArray<FAssetDuplicateGroup> SortedGroups;
+	SortedGroups.Reserve(DuplicateGroups.Num());
+	for (const int32 Slot : SortedSlots)
+	{
+		SortedGroups.Add(MoveTemp(DuplicateGroups[ GroupBySlot.FindChecked(Slot) ]));
+	}
+	DuplicateGroups = MoveTemp(SortedGroups);
+}
+void SAdvanceDeletionsTab::StatAssetFiles()
+{
+	if (FileStatProgress.IsValid())
+	{
+		FileStatProgress->RequestCancel();
+	}
+
+	AssetFileSizes.Init(INDEX_NONE, StoredAssetsData.Num());
+	AssetModifiedTicks.Init(0, StoredAssetsData.Num());
+	RecountSelection();
+
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(StoredAssetsData.Num());
+	for (const TSharedPtr<FAssetData>& AssetData : StoredAssetsData)
+	{
+		PackageNames.Add(AssetData->PackageName);
+	}
+
+	// A newer scan cancels this one, so every batch that arrives still matches the stored slots
+	const TSharedRef<FAssetScanProgress> Progress = MakeShared<FAssetScanProgress>();
+	FileStatProgress = Progress;
+
+	TWeakPtr<SAdvanceDeletionsTab> WeakTab = StaticCastSharedRef<SAdvanceDeletionsTab>(AsShared());
+	FAssetFileStatScan::Launch(MoveTemp(PackageNames), Progress, [WeakTab, Progress](FAssetFileStatScan::FBatch&& Batch)
+	{
+		using namespace AdvancedDeletionWidget;
+
+		const TSharedPtr<SAdvanceDeletionsTab> Tab = WeakTab.Pin();
+		if (!Tab.IsValid())
+		{
+			return;
+		}
+
+		for (int32 BatchIndex = 0; BatchIndex < Batch.FileSizes.Num(); ++BatchIndex)
+		{
+			const int32 StoredIndex = Batch.FirstIndex + BatchIndex;
+			Tab->AssetFileSizes[ StoredIndex ] = Batch.FileSizes[ BatchIndex ];
+			Tab->AssetModifiedTicks[ StoredIndex ] = Batch.ModifiedTicks[ BatchIndex ];
+
+			if (Tab->SelectedAssetBits[ StoredIndex ])
+			{
+				Tab->SelectedFileSize += FMath::Max<int64>(Batch.FileSizes[ BatchIndex ], 0);
+			}
+		}
+
+		// Rows don't move while sizes come in, the list is sorted once they are all known. Progress counts this batch after it returns.
+		const bool bSortedByFileStat = Tab->SortColumn == SizeColumn || Tab->SortColumn == ModifiedColumn;
+		if (bSortedByFileStat && Progress->GetCompleted() + Batch.FileSizes.Num() == Progress->GetTotal())
+		{
+			Tab->SortViewAssets();
+			Tab->RebuildDisplayedAssets();
+			if (Tab->ConstructedAssetListView.IsValid())
+			{
+				Tab->ConstructedAssetListView->RequestTreeRefresh();
+			}
+		}
+	});
+}
+FText SAdvanceDeletionsTab::GetAssetFileSizeText(TSharedPtr<FAssetData> AssetData) const
+{
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+	if (!StoredIndex || AssetFileSizes[ *StoredIndex ] < 0)
+	{
+		return FText::GetEmpty();
+	}
+	return FText::AsMemory(AssetFileSizes[ *StoredIndex ]);
+}
+FText SAdvanceDeletionsTab::GetAssetModifiedText(TSharedPtr<FAssetData> AssetData) const
+{
+	const int32* StoredIndex = StoredAssetIndices.Find(AssetData);
+	if (!StoredIndex || AssetModifiedTicks[ *StoredIndex ] <= 0)
+	{
+		return FText::GetEmpty();
+	}
+	return FText::AsDate(FDateTime(AssetModifiedTicks[ *StoredIndex ]));
 }
@@ -11,6 +11,9 @@ class EDITOREXTENSIONS_API UAssetActionExtender : public UAssetActionUtility
 
 public:
 	static void FixUpRedirectors();
+	// Only redirectors inside the folders or referenced from them are loaded and fixed, chains are collapsed.
+	// Goes through the module's FRedirectorFixupService, so it costs nothing while no redirector is pending.
+	static void FixUpRedirectors(const TArray<FString>& ScopeFolderPaths);
 
 	UFUNCTION(CallInEditor)
 	void SmartDuplicate(int32 NumOfDuplicates);
@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Folder and package enumeration through a single FARFilter registry query, returning FAssetData directly
+ * instead of listing paths and looking each one up again. Redirectors are skipped.
+ * Off the game thread only on-disk assets are returned, in-memory ones can't be visited there.
+ */
+class EDITOREXTENSIONS_API FAssetFolderEnumerator
+{
+public:
+	static void GetAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutAssets, bool bRecursive = true);
+	static void GetAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutAssets, bool bRecursive = true);
+	static void GetAssetsInPackages(const TArray<FName>& PackageNames, TArray<FAssetData>& OutAssets);
+
+private:
+	static void RunQuery(struct FARFilter& Filter, TArray<FAssetData>& OutAssets);
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetDeletion/AssetExclusionMatcher.h"
+#include "AssetDeletion/AssetScanProgress.h"
+#include "Containers/Queue.h"
+
+/**
+ * Lists the assets under a set of folders on the thread pool, one folder per registry query, and queues each
+ * folder's assets as soon as it is listed so the game thread can show them while the rest is still enumerated.
+ * Redirectors and assets in excluded folders are skipped, and only on-disk assets are returned.
+ */
+class EDITOREXTENSIONS_API FAssetFolderStream
+{
+public:
+	static TSharedRef<FAssetFolderStream> Launch(const TArray<FString>& RootPaths, const FAssetExclusionMatcher& Matcher);
+
+	// Single consumer. Takes whole folders until at least MaxAssets were moved into OutAssets or the queue is empty.
+	void Dequeue(TArray<TSharedPtr<FAssetData>>& OutAssets, int32 MaxAssets);
+
+	// Every folder was listed and every queued asset was taken
+	bool IsFinished() const;
+	void Cancel() { Progress.RequestCancel(); }
+
+	const TArray<FString>& GetRootPaths() const { return RootPaths; }
+
+	// Counts folders, not assets
+	const FAssetScanProgress& GetProgress() const { return Progress; }
+	int32 GetNumExcludedAssets() const { return NumExcludedAssets.load(std::memory_order_relaxed); }
+
+private:
+	TArray<FString> RootPaths;
+	TQueue<TArray<TSharedPtr<FAssetData>>, EQueueMode::Spsc> FolderBatches;
+	FAssetScanProgress Progress;
+	std::atomic<bool> bEnumerated { false };
+	std::atomic<int32> NumExcludedAssets { 0 };
+};
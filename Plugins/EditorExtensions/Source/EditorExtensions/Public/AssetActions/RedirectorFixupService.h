@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Owns redirector fixup for the plugin. Registry events record which redirectors appeared since the last fixup,
+ * so a request with nothing pending returns right away and each redirector is looked at once however many
+ * callers ask. Redirectors outside a request's scope stay pending for a later request.
+ */
+class EDITOREXTENSIONS_API FRedirectorFixupService
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	void RequestFixup(const TArray<FString>& ScopeFolderPaths);
+
+	bool HasPendingRedirectors() const { return bNeedsInitialScan || !PendingRedirectorPackages.IsEmpty(); }
+
+private:
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+private:
+	// Redirectors left over from before this session are only known after the first full query
+	bool bNeedsInitialScan = true;
+	bool bFixupInProgress = false;
+
+	TSet<FName> PendingRedirectorPackages;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
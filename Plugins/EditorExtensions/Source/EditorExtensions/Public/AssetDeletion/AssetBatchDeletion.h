@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Deletes assets in batches bounded by count and package size, collecting garbage between batches
+ * so a large cleanup never has every asset loaded at the same time.
+ */
+class EDITOREXTENSIONS_API FAssetBatchDeletion
+{
+public:
+	// Confirms once for the whole list, naming assets that are still referenced from outside it and keeping those,
+	// then deletes batch by batch and reports every asset that was not deleted. Returns the number of deleted assets.
+	static int32 DeleteAssets(const TArray<FAssetData>& AssetsToDelete);
+
+private:
+	static void SplitByExternalReferencers(const TArray<FAssetData>& AssetsToDelete, TArray<FAssetData>& OutUnreferenced, TArray<FAssetData>& OutReferenced);
+	// Groups of assets that reference each other, referencing groups before the groups they reference
+	static void OrderForDeletion(const TArray<FAssetData>& AssetsToDelete, TArray<TArray<FAssetData>>& OutDeletionGroups);
+	static void SplitIntoBatches(const TArray<TArray<FAssetData>>& DeletionGroups, TArray<TArray<FAssetData>>& OutBatches);
+};
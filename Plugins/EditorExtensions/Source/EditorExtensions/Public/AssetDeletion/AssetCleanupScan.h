@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetDeletion/AssetScanProgress.h"
+
+class SNotificationItem;
+
+/**
+ * Runs a scan on the thread pool behind a progress notification with a Cancel button.
+ * The completion callback runs on the game thread from the core ticker, and only if the scan wasn't cancelled.
+ */
+class EDITOREXTENSIONS_API FAssetCleanupScan : public TSharedFromThis<FAssetCleanupScan>
+{
+public:
+	static TSharedRef<FAssetCleanupScan> Launch(const FText& InTitle, TUniqueFunction<void(FAssetScanProgress&)>&& ScanWork, TUniqueFunction<void()>&& InOnCompleted);
+
+	void Cancel();
+
+	// Only once the completion callback has returned
+	bool IsFinished() const { return bFinished; }
+
+private:
+	bool TickProgress(float DeltaTime);
+	void Finish();
+
+private:
+	FText Title;
+	FAssetScanProgress Progress;
+	std::atomic<bool> bWorkDone { false };
+	bool bFinished = false;
+
+	TUniqueFunction<void()> OnCompleted;
+
+	TSharedPtr<SNotificationItem> Notification;
+};
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+class FAssetScanCache;
+class FAssetScanProgress;
+struct FAssetScanCacheEntry;
+
+/**
+ * XXH64 of package files on disk, hashed in parallel across the scan workers and streamed in fixed size blocks.
+ * The raw header is skipped since it holds the package name, GUIDs and offsets. Its name table and import table are
+ * hashed as text instead, imports resolved to full object paths and the package's own name replaced by a
+ * placeholder, so copies that only differ by name still match but packages importing different objects don't.
+ */
+class EDITOREXTENSIONS_API FAssetContentHasher
+{
+public:
+	// Returns false if the scan was cancelled. Packages without a file on disk get no entry.
+	// Hashes still valid in the cache are reused, and freshly computed ones are returned for the caller to store.
+	static bool HashPackages(const TArray<FName>& PackageNames, TMap<FName, uint64>& OutPackageHashes, FAssetScanProgress* Progress = nullptr,
+		const FAssetScanCache* Cache = nullptr, TMap<FName, FAssetScanCacheEntry>* OutNewCacheEntries = nullptr);
+
+	// One stat for the common case, maps are only looked for when there is no .uasset
+	static bool FindPackageFile(FName PackageName, FString& OutFilename, FFileStatData& OutStatData);
+
+	static bool HashPackageFile(FName PackageName, const FString& Filename, TArray<uint8>& ReadBuffer, uint64& OutHash);
+};
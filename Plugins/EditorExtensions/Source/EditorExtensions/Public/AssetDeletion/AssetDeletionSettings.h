@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AssetDeletionSettings.generated.h"
+
+UENUM()
+enum class E_AssetExclusionRuleType : uint8
+{
+	EAER_Prefix UMETA(DisplayName = "Folder Prefix", ToolTip = "/Game/Developers excludes that folder and everything under it"),
+	EAER_Segment UMETA(DisplayName = "Folder Name", ToolTip = "__ExternalActors__ excludes every folder with that name, at any depth"),
+	EAER_Glob UMETA(DisplayName = "Wildcard", ToolTip = "*/Prototype* matched against the whole folder path, * and ? supported")
+};
+
+USTRUCT()
+struct FAssetExclusionRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Exclusions")
+	E_AssetExclusionRuleType RuleType = E_AssetExclusionRuleType::EAER_Segment;
+
+	UPROPERTY(EditAnywhere, Category = "Exclusions")
+	FString Pattern;
+};
+
+UCLASS(Config=EditorExtensions, defaultconfig, meta = (DisplayName="Asset Deletion Settings"))
+class EDITOREXTENSIONS_API UAssetDeletionSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	virtual FName GetCategoryName() const override { return "Plugins"; }
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ToolTip = "Every map in the project keeps its dependencies alive"))
+	bool bMapsAreRoots = true;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ToolTip = "Primary assets known to the Asset Manager keep their dependencies alive"))
+	bool bPrimaryAssetsAreRoots = true;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ToolTip = "Project Settings > Packaging > Additional Asset Directories to Cook"))
+	bool bAlwaysCookDirectoriesAreRoots = true;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ToolTip = "Maps, game mode and game instance set in Project Settings > Maps & Modes, and the classes and assets set in the engine's config, keep their dependencies alive"))
+	bool bConfigAssetsAreRoots = true;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ContentDir))
+	TArray<FDirectoryPath> AdditionalRootDirectories;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Reachability Roots", meta = (ToolTip = "Assets that keep their dependencies alive. Assets only referenced from C++, by hard coded path or ConstructorHelpers, are invisible to the asset registry and have to be added here"))
+	TArray<FSoftObjectPath> AdditionalRootAssets;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Exclusions", meta = (ToolTip = "Folders cleanup never deletes from. Rules match content folder paths, case insensitive"))
+	TArray<FAssetExclusionRule> ExclusionRules;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Similar Textures", meta = (ClampMin = 0, ClampMax = 7, ToolTip = "Most differing bits between two 64 bit texture hashes that still count as the same image. 0 only matches identical hashes"))
+	int32 SimilarTextureMaxDistance = 5;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, ClampMax = 64, ToolTip = "Worker threads used by asset scans. 0 uses every task graph worker, 1 runs the scan on a single background worker"))
+	int32 ScanWorkerCount = 0;
+
+	int32 GetScanWorkerCount() const;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, ToolTip = "Most assets loaded and deleted at once. 0 disables the count limit"))
+	int32 DeletionBatchSize = 250;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, Units = "Megabytes", ToolTip = "Most package data on disk loaded per deletion batch, garbage is collected between batches. 0 disables the memory limit"))
+	int32 DeletionBatchMemoryBudgetMB = 4096;
+
+	UPROPERTY(EditAnywhere, Config, Category = "Performance", meta = (ClampMin = 0, Units = "Megabytes", ToolTip = "Most source image data decoded at once while hashing similar textures. A larger texture is still hashed, alone. 0 disables the memory limit"))
+	int32 TextureHashMemoryBudgetMB = 1024;
+};
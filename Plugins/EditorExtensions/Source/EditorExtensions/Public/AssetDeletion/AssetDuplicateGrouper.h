@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetDuplicateGroup
+{
+	// In list order, the first asset stands for the group
+	TArray<TSharedPtr<FAssetData>> Assets;
+	int64 TotalDiskSize = 0;
+
+	// Set by scans that can tell, memory freed by keeping only the largest asset
+	int64 ReclaimableMemory = 0;
+};
+
+/**
+ * Buckets assets by one key in a single hashed pass and keeps the buckets holding more than one asset.
+ * Groups come out in the order their first asset appears in the input.
+ */
+class EDITOREXTENSIONS_API FAssetDuplicateGrouper
+{
+public:
+	static void GroupByName(const TArray<TSharedPtr<FAssetData>>& Assets, TArray<FAssetDuplicateGroup>& OutGroups);
+	static void GroupByContentHash(const TArray<TSharedPtr<FAssetData>>& Assets, const TMap<FName, uint64>& PackageHashes, TArray<FAssetDuplicateGroup>& OutGroups);
+	// Packages whose hashes differ in at most MaxHammingDistance bits end up in one group, chained matches included
+	static void GroupByNearHash(const TArray<TSharedPtr<FAssetData>>& Assets, const TMap<FName, uint64>& PackageHashes, int32 MaxHammingDistance, TArray<FAssetDuplicateGroup>& OutGroups);
+
+private:
+	static void FinishGroups(TArray<FAssetDuplicateGroup>& InOutGroups);
+};
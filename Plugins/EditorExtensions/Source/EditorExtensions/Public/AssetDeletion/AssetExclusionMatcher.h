@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetDeletion/AssetDeletionSettings.h"
+
+/**
+ * Exclusion rules compiled for bulk matching. Prefix rules live in a trie keyed by folder name, so a path is
+ * checked in one walk over its segments whatever the number of rules; only wildcard rules are tested one by one.
+ */
+class EDITOREXTENSIONS_API FAssetExclusionMatcher
+{
+public:
+	void Compile(const TArray<FAssetExclusionRule>& Rules);
+
+	bool IsFolderExcluded(const FString& FolderPath) const;
+
+	// Remove excluded entries in place and return how many were removed. Assets are matched by their package path.
+	int32 RemoveExcludedAssets(TArray<FAssetData>& InOutAssets) const;
+	int32 RemoveExcludedFolders(TArray<FString>& InOutFolderPaths) const;
+
+private:
+	struct FPrefixNode
+	{
+		TMap<FString, int32> Children;
+		bool bIsRuleEnd = false;
+	};
+
+	TArray<FPrefixNode> PrefixNodes;
+	TSet<FString> ExcludedSegments;
+	TArray<FString> GlobPatterns;
+};
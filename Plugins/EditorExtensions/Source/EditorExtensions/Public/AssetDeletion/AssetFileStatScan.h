@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetScanProgress;
+
+/**
+ * Package file sizes and modification times, read with parallel stat calls across the scan workers.
+ * Results reach the game thread one batch at a time, so lists can show them while the rest are still being read.
+ */
+class EDITOREXTENSIONS_API FAssetFileStatScan
+{
+public:
+	struct FBatch
+	{
+		int32 FirstIndex = 0;
+
+		// INDEX_NONE and 0 for packages without a file on disk
+		TArray<int64> FileSizes;
+		TArray<int64> ModifiedTicks;
+	};
+
+	// OnBatchDone runs on the game thread, batches arrive in no particular order and stop once Progress is cancelled.
+	// Progress advances after each batch is handed over, not when it is read.
+	static void Launch(TArray<FName>&& PackageNames, const TSharedRef<FAssetScanProgress>& Progress, TFunction<void(FBatch&&)>&& OnBatchDone);
+
+private:
+	static constexpr int32 BatchSize = 256;
+};
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetReferenceIndex;
+
+/**
+ * Marks every package reachable from the configured root set in one traversal of the dependency graph.
+ * Anything left unmarked is dead, including assets only referenced by other dead assets.
+ */
+class EDITOREXTENSIONS_API FAssetReachabilityAnalyzer
+{
+public:
+	void Analyze(const FAssetReferenceIndex& ReferenceIndex);
+
+	bool IsPackageReachable(FName PackageName) const;
+
+	void FilterUnreachableAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnreachableAssets) const;
+	void FilterUnreachableAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnreachableAssets) const;
+
+private:
+	static void CollectRootPackages(TArray<FName>& OutRootPackages);
+
+private:
+	TSet<FName> ReachablePackages;
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reverse-dependency index built from the asset registry in a single pass.
+ * Replaces per-asset referencer queries when filtering large folders for unused assets.
+ * Forward dependencies are kept per package so single packages can be re-indexed incrementally.
+ */
+class EDITOREXTENSIONS_API FAssetReferenceIndex
+{
+public:
+	// Returns false if the scan was cancelled through Progress, leaving the index empty
+	bool Build(class FAssetScanProgress* Progress = nullptr);
+	void Reset();
+
+	// Re-queries the registry for this package. Every package whose referencer count may have changed is added to OutTouchedPackages.
+	void AddOrUpdatePackage(FName PackageName, TSet<FName>& OutTouchedPackages);
+	void RemovePackage(FName PackageName, TSet<FName>& OutTouchedPackages);
+
+	bool ContainsPackage(FName PackageName) const;
+	bool IsPackageReferenced(FName PackageName) const;
+	int32 GetReferencerCount(FName PackageName) const;
+
+	void FilterUnreferencedAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnreferencedAssets) const;
+	void FilterUnreferencedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnreferencedAssets) const;
+
+	const TMap<FName, TArray<FName>>& GetPackageDependencies() const { return PackageDependencies; }
+
+private:
+	static void QueryDependencies(const class IAssetRegistry& AssetRegistry, FName PackageName, TArray<FName>& OutDependencies);
+
+	void AddReferences(const TArray<FName>& Dependencies);
+	void RemoveReferences(const TArray<FName>& Dependencies);
+
+private:
+	// Package name -> packages it depends on, self references excluded
+	TMap<FName, TArray<FName>> PackageDependencies;
+
+	// Package name -> number of distinct packages referencing it. Unreferenced packages are absent.
+	TMap<FName, int32> ReferencerCounts;
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+enum class EAssetScanCacheField : uint32
+{
+	None = 0,
+	ContentHash = 1 << 0,
+	PerceptualHash = 1 << 1,
+	GeometryHash = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EAssetScanCacheField);
+
+struct FAssetScanCacheEntry
+{
+	// Key of the package file the fields were computed from
+	int64 FileSize = 0;
+	int64 ModifiedTicks = 0;
+
+	EAssetScanCacheField ValidFields = EAssetScanCacheField::None;
+	uint64 ContentHash = 0;
+
+	// Textures only
+	uint64 PerceptualHash = 0;
+	int64 TextureMemorySize = 0;
+
+	// Static meshes only
+	uint64 GeometryHash = 0;
+
+	bool MatchesFile(const int64 InFileSize, const int64 InModifiedTicks) const
+	{
+		return FileSize == InFileSize && ModifiedTicks == InModifiedTicks;
+	}
+	bool MatchesFile(const FFileStatData& StatData) const
+	{
+		return MatchesFile(StatData.FileSize, StatData.ModificationTime.GetTicks());
+	}
+};
+
+/**
+ * Per-package scan results kept across editor sessions in Saved/EditorExtensions. An entry is only trusted while
+ * the package file keeps the size and timestamp it was computed from, so a rescan only reads packages that changed.
+ * The file is read through a memory map at startup and written back after scans that added entries.
+ */
+class EDITOREXTENSIONS_API FAssetScanCache
+{
+public:
+	static FString GetCacheFilename();
+
+	bool Load();
+	bool Save();
+
+	// Null when nothing is cached or the package changed on disk since
+	const FAssetScanCacheEntry* FindValid(FName PackageName, const FFileStatData& StatData) const;
+	void Store(FName PackageName, const FAssetScanCacheEntry& Entry);
+
+	bool IsDirty() const { return bDirty; }
+
+private:
+	TMap<FName, FAssetScanCacheEntry> Entries;
+	bool bDirty = false;
+};
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Progress and cancellation shared between a scan running on worker threads and the game thread watching it.
+ */
+class FAssetScanProgress
+{
+public:
+	void SetTotal(const int32 InTotal) { Total.store(InTotal, std::memory_order_relaxed); }
+	void AddTotal(const int32 NumAdded) { Total.fetch_add(NumAdded, std::memory_order_relaxed); }
+	void Advance(const int32 NumCompleted = 1) { Completed.fetch_add(NumCompleted, std::memory_order_relaxed); }
+
+	int32 GetTotal() const { return Total.load(std::memory_order_relaxed); }
+	int32 GetCompleted() const { return Completed.load(std::memory_order_relaxed); }
+
+	void RequestCancel() { bCancelRequested.store(true, std::memory_order_relaxed); }
+	bool IsCancelRequested() const { return bCancelRequested.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<int32> Total { 0 };
+	std::atomic<int32> Completed { 0 };
+	std::atomic<bool> bCancelRequested { false };
+};
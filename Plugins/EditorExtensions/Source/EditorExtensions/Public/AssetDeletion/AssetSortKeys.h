@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Sort keys for a list of assets, one array per key and one slot per asset. Names, classes and paths are stored as
+ * their rank among the distinct values, so strings are compared once per distinct value while building and sorting
+ * only ever compares integers. Built off the game thread, the registry is only read. File sizes and times come
+ * from FAssetFileStatScan, which reports them progressively.
+ */
+struct EDITOREXTENSIONS_API FAssetSortKeys
+{
+	TArray<int32> NameRanks;
+	TArray<int32> ClassRanks;
+	TArray<int32> PathRanks;
+	TArray<int32> ReferencerCounts;
+
+	void Build(const TArray<TSharedPtr<FAssetData>>& Assets);
+
+	// Drops the flagged slots and keeps the rest in order. Ranks stay comparable, they just stop being contiguous.
+	void RemoveSlots(const TBitArray<>& RemovedSlots);
+
+	int32 Num() const { return NameRanks.Num(); }
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Matches of one query, kept so the next keystroke can narrow them down instead of searching again
+struct FAssetTextFilterResult
+{
+	TArray<FString> Terms;
+	TArray<TArray<int32>> MatchedTokensPerTerm;
+	TArray<int32> MatchedEntries;
+
+	// Token numbers only mean something to the index build that produced them
+	uint32 IndexBuildId = 0;
+};
+
+/**
+ * Search index over asset names, paths, classes and tag values. Entries are asset slots, tokens are the distinct
+ * lowercase field strings. Paths, classes and tag values repeat across thousands of assets, so a query scans the far
+ * smaller token list and then follows each matching token to its entries.
+ * Immutable once built, queries may run on any thread.
+ */
+class EDITOREXTENSIONS_API FAssetTextFilterIndex
+{
+public:
+	void Build(const TArray<TSharedPtr<FAssetData>>& InAssets);
+
+	// Entries containing every whitespace separated term, case insensitive. A previous result for a shorter query
+	// limits the tokens scanned, since a token that contains the longer term also contained the shorter one.
+	void Query(const FString& QueryText, FAssetTextFilterResult& OutResult, const FAssetTextFilterResult* PreviousResult = nullptr) const;
+
+	// Same match as Query for a single asset, for assets added after the index was built
+	static bool MatchesTerms(const FAssetData& AssetData, const TArray<FString>& Terms);
+
+	int32 Num() const { return Assets.Num(); }
+	const TSharedPtr<FAssetData>& GetAsset(const int32 EntryIndex) const { return Assets[ EntryIndex ]; }
+
+private:
+	uint32 BuildId = 0;
+	TArray<TSharedPtr<FAssetData>> Assets;
+
+	TArray<FString> Tokens;
+	// Ascending, no duplicates
+	TArray<TArray<int32>> EntriesByToken;
+};
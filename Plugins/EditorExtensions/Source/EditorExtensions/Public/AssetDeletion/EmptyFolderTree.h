@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetExclusionMatcher;
+class FAssetScanProgress;
+
+/**
+ * Folder tree under one cleanup root, built from a single sub-path listing and a single asset enumeration.
+ * Emptiness of every folder is settled in one children-before-parents pass, and the result is reported as the
+ * topmost empty folders, so a folder holding only empty folders is removed as one unit.
+ */
+class EDITOREXTENSIONS_API FEmptyFolderTree
+{
+public:
+	// Returns false if the scan was cancelled
+	bool Build(const FString& RootPath, const FAssetExclusionMatcher& ExclusionMatcher, FAssetScanProgress& Progress);
+
+	const TArray<FString>& GetEmptySubtreeRoots() const { return EmptySubtreeRoots; }
+	int32 GetNumEmptyFolders() const { return NumEmptyFolders; }
+	int32 GetNumExcludedFolders() const { return NumExcludedFolders; }
+
+private:
+	struct FFolderNode
+	{
+		FString Path;
+		int32 ParentIndex = INDEX_NONE;
+		// Holds assets, is excluded, or has such a folder below it
+		bool bHasContent = false;
+	};
+
+	TArray<FFolderNode> Nodes;
+
+	TArray<FString> EmptySubtreeRoots;
+	int32 NumEmptyFolders = 0;
+	int32 NumExcludedFolders = 0;
+};
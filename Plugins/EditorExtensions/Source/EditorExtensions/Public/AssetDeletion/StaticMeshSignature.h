@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetScanProgress;
+struct FMeshDescription;
+
+/**
+ * Geometry signature of static meshes in two steps. The registry tags every mesh with its vertex, triangle, LOD and
+ * material counts and rounded bounds, which separates almost all meshes without loading anything. Only meshes that
+ * still share those tags need their geometry hashed, which is what tells real copies apart.
+ */
+class EDITOREXTENSIONS_API FStaticMeshSignature
+{
+public:
+	// False when the registry has no geometry tags for the asset, e.g. packages saved before the tags existed
+	static bool GetTagKey(const FAssetData& AssetData, uint64& OutKey);
+	static uint64 CombineKeys(uint64 TagKey, uint64 GeometryHash);
+
+	// Plain copy of the parts of a mesh description the signature covers, snapped to the hashing grids. Taken on the
+	// game thread, so workers never read a description that a reimport or build can change under them.
+	struct FGeometry
+	{
+		TArray<FIntVector> GridPositions;
+
+		// Three per triangle
+		TArray<int32> CornerVertices;
+		TArray<FIntPoint> CornerGridUVs;
+
+		// One per triangle, indexing MaterialSlotNames
+		TArray<int32> TriangleSlots;
+		TArray<FString> MaterialSlotNames;
+	};
+
+	// Game thread only. False when the description has no vertex positions.
+	static bool ExtractGeometry(const FMeshDescription& MeshDescription, FGeometry& OutGeometry);
+
+	// Returns false if the scan was cancelled. OutHashes has one slot per geometry, unset for unset entries.
+	static bool HashGeometries(const TArray<TOptional<FGeometry>>& Geometries, TArray<TOptional<uint64>>& OutHashes, FAssetScanProgress* Progress = nullptr);
+
+	// Vertex positions snapped to a 0.01 unit grid, plus each triangle's corners by their rank in the sorted positions
+	// with UV0 and the material slot name. Independent of vertex and triangle order.
+	static uint64 HashGeometry(const FGeometry& Geometry);
+};
@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetScanProgress;
+class FTextureSource;
+
+/**
+ * 64 bit difference hash of a texture image. Luminance is box filtered down to a 9x8 grid and each bit records
+ * whether a cell is darker than its right neighbour, so resized, recompressed or re-exported copies of an image
+ * land a few bits apart and are found by Hamming distance.
+ */
+class EDITOREXTENSIONS_API FTexturePerceptualHasher
+{
+public:
+	// Returns false if the scan was cancelled. OutHashes has one slot per source, unset when it has no usable data.
+	// Sources are torn off copies made on the game thread, so the textures can be edited or collected meanwhile.
+	// Decoding is held back while other workers' images would exceed TextureHashMemoryBudgetMB.
+	static bool HashTextures(TArray<FTextureSource>& Sources, TArray<TOptional<uint64>>& OutHashes, FAssetScanProgress* Progress = nullptr);
+
+	// Reads the smallest source mip that still covers the grid with several pixels per cell
+	static bool HashTextureSource(FTextureSource& Source, uint64& OutHash);
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetDeletion/AssetReferenceIndex.h"
+
+/**
+ * Keeps the set of unreferenced packages up to date from asset registry events.
+ * Events only queue packages; the queue is applied on the next query, so bursts of saves or renames are coalesced.
+ */
+class EDITOREXTENSIONS_API FUnusedAssetTracker
+{
+public:
+	void Initialize();
+	void Shutdown();
+
+	// Cost scales with the number of folders holding unused assets and the size of the answer, not with the project
+	void GetUnusedAssetsUnderFolder(const FString& FolderPath, TArray<FAssetData>& OutUnusedAssets);
+	void GetUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths, TArray<FAssetData>& OutUnusedAssets);
+
+	bool IsPackageUnused(FName PackageName);
+	void FilterUnusedAssets(const TArray<FAssetData>& AssetsToFilter, TArray<FAssetData>& OutUnusedAssets);
+	void FilterUnusedAssets(const TArray<TSharedPtr<FAssetData>>& AssetsToFilter, TArray<TSharedPtr<FAssetData>>& OutUnusedAssets);
+
+	const FAssetReferenceIndex& GetReferenceIndex();
+
+	// Lets a background scan build the first index off the game thread. Events arriving meanwhile are replayed after AdoptIndex.
+	bool NeedsIndexBuild() const { return !bIndexBuilt; }
+	void BeginExternalIndexBuild();
+	void AdoptIndex(FAssetReferenceIndex&& BuiltIndex);
+
+private:
+	void FlushPendingPackages();
+	void RebuildUnusedPackages();
+	void RefreshUnusedState(FName PackageName);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+
+private:
+	FAssetReferenceIndex ReferenceIndex;
+	bool bIndexBuilt = false;
+	bool bRecordEvents = false;
+
+	TSet<FName> PendingPackages;
+
+	// Unused package name -> its package path, and package path -> unused packages in it
+	TMap<FName, FName> UnusedPackagePaths;
+	TMap<FName, TSet<FName>> UnusedPackagesByPath;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+};
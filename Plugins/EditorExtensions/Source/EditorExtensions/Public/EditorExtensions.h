@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "AssetDeletion/AssetExclusionMatcher.h"
 
 class FEditorExtensionsModule : public IModuleInterface
 {
@@ -13,10 +14,23 @@ public:
 
 public:
 	bool DeleteAsset(const FAssetData& AssetData);
-	bool DeleteAssets(TArray<FAssetData> SelectedAssetData);
+	bool DeleteAssets(const TArray<FAssetData>& SelectedAssetData);
 
 	void GetUnusedAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData);
+	void GetUnreachableAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData);
+	class FUnusedAssetTracker& GetUnusedAssetTracker() const;
+	class FRedirectorFixupService& GetRedirectorFixupService() const;
+	class FAssetScanCache& GetAssetScanCache() const;
 	void GetDuplicatedAssetData(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<TSharedPtr<FAssetData>>& FilteredAssetData);
+	void GetDuplicatedAssetGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TArray<struct FAssetDuplicateGroup>& OutGroups);
+	// Only one of the hashing scans below runs at a time, the others refuse to start meanwhile
+	bool IsCleanupScanRunning() const;
+	// Hashes package files on the thread pool, OnFound runs on the game thread with the groups of identical assets
+	void FindContentDuplicatedAssetGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<struct FAssetDuplicateGroup>&&)>&& OnFound);
+	// Loads textures missing from the scan cache, hashes their source images on the thread pool and groups look-alikes
+	void FindSimilarTextureGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<struct FAssetDuplicateGroup>&&)>&& OnFound);
+	// Groups static meshes with the same geometry. Registry tags rule out most meshes, only those sharing tags are loaded.
+	void FindIdenticalMeshGroups(const TArray<TSharedPtr<FAssetData>>& AssetDataToFilter, TUniqueFunction<void(TArray<struct FAssetDuplicateGroup>&&)>&& OnFound);
 
 	void SyncCBToClickedAsset(const FString& AssetPath);
 
@@ -31,19 +45,34 @@ private:
 	TWeakObjectPtr<class UEditorActorSubsystem> WeakEditorActorSubsystem;
 
 	TSharedPtr<class FUICommandList> CustomUICommands;
+
+	TSharedPtr<class FUnusedAssetTracker> UnusedAssetTracker;
+	TSharedPtr<class FRedirectorFixupService> RedirectorFixupService;
+	TSharedPtr<class FAssetScanCache> AssetScanCache;
+	TSharedPtr<class FAssetCleanupScan> ActiveCleanupScan;
+
+	FAssetExclusionMatcher ExclusionMatcher;
+	FDelegateHandle DeletionSettingsChangedHandle;
 private:
 	void InitCBMenuExtension();
 	void AddCBMenuEntry(class FMenuBuilder& MenuBuilder);
 
 	void OnDeleteUnusedAssets();
+	void OnDeleteUnreachableAssets();
+	void DeleteUnusedAssetsUnderFolders(const TArray<FString>& FolderPaths);
+	void DeleteFoundAssets(const TArray<FAssetData>& FoundAssetsData);
 	void OnEmptyFoldersAndAssetsDelete();
+
+	bool CanStartFolderCleanup() const;
+	TArray<FString> GetSelectedCleanupRoots() const;
+	void LaunchIndexedCleanupScan(const FString& ScanTitle, TUniqueFunction<void()>&& OnIndexReady);
+	void LaunchEmptyFoldersScan(const TArray<FString>& FolderPaths);
+	void CompileExclusionRules();
 	void OnAdvancedDeletion();
 	
 	void RegisterAdvancedDeletionTab();
 	TSharedRef<SDockTab> OnSpawnAdvanceDeletion(const FSpawnTabArgs& SpawnTabArgs);
 
-	TArray<TSharedPtr<FAssetData>> GetAllAssetDataUnderSelectedFolder();
-
 	void InitLevelEditorExtension();
 
 	TSharedRef<FExtender> CustomLevelEditorMenuExtender(const TSharedRef<FUICommandList> UICommandList, const TArray<AActor*> SelectedActors);
@@ -3,6 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AssetDeletion/AssetDuplicateGrouper.h"
+
+class FAssetFolderStream;
+class FAssetScanProgress;
+class FAssetTextFilterIndex;
+struct FAssetSortKeys;
+struct FAssetTextFilterResult;
 
 class SAdvanceDeletionsTab : public SCompoundWidget
 {
@@ -10,45 +17,161 @@ class SAdvanceDeletionsTab : public SCompoundWidget
 
 	SLATE_ARGUMENT(TArray<TSharedPtr<FAssetData>>, AssetsDataToStore);
 
+	// Appended to the stored assets batch by batch while the tab is already open
+	SLATE_ARGUMENT(TSharedPtr<FAssetFolderStream>, AssetStream);
+
 	SLATE_END_ARGS();
 
 public:
 	void Construct(const FArguments& InArgs);
+	virtual ~SAdvanceDeletionsTab() override;
 
 private:
 	FSlateFontInfo GetEmbossedTextFont() const;
 	void RefreshAssetListView();
 
-	TSharedRef<SListView<TSharedPtr<FAssetData>>> ConstructAssetListView();
+	EActiveTimerReturnType PumpAssetStream(double InCurrentTime, float InDeltaTime);
+	void AppendStoredAssets(TArray<TSharedPtr<FAssetData>>&& NewAssetsData);
+	void OnAssetStreamFinished();
+	FText GetAssetCountText() const;
+	bool IsListingAllAssets() const;
+
+	TSharedRef<STreeView<TSharedPtr<FAssetData>>> ConstructAssetListView();
+	void OnGetChildrenForList(TSharedPtr<FAssetData> AssetData, TArray<TSharedPtr<FAssetData>>& OutChildren);
 	TSharedRef<SComboBox<TSharedPtr<FString>>> ConstructComboBox();
 	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetData> AssetDataToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SWidget> OnGenerateCellForList(const FName& ColumnName, const TSharedRef<ITableRow>& Row, TSharedPtr<FAssetData> AssetDataToDisplay);
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(EColumnSortPriority::Type SortPriority, const FName& ColumnId, EColumnSortMode::Type InSortMode);
 	TSharedRef<SCheckBox> ConstructCheckBox(const TSharedPtr<FAssetData>& AssetDataToDisplay);
 	TSharedRef<SCheckBox> ConstructGlobalCheckBox();
-	TSharedRef<STextBlock> ConstructTextBLock(const FString& TextContent, const FSlateFontInfo& FontToUse, const FColor& ColorToUse = FColor::White);
+	TSharedRef<SButton> ConstructInvertSelectionButton();
+	TSharedRef<SWidget> ConstructSearchBox();
+	TSharedRef<STextBlock> ConstructTextBLock(const FText& TextContent, const FSlateFontInfo& FontToUse, const FColor& ColorToUse = FColor::White);
 	TSharedRef<SButton> ConstructDeleteButton(const TSharedPtr<FAssetData>& AssetDataToDisplay);
 	TSharedRef<SButton> ConstructDeleteSelectedButton();
 
 	TSharedRef<SWidget> OnGenerateComboContent(TSharedPtr<FString> SourceItem);
 	void OnComboSelectionChanged(TSharedPtr<FString> SelectedOption, ESelectInfo::Type InSelectInfo);
+	void LaunchHashedView(const TSharedPtr<FString>& SelectedOption);
+	EActiveTimerReturnType PollQueuedHashedView(double InCurrentTime, float InDeltaTime);
+	void CacheListView(const FString& ListOption);
+	void InvalidateListViewCache();
+	void OnAssetRegistryChanged(const FAssetData& AssetData);
+	void OnAssetRegistryRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
 	void OnRowWidgetMouseButtonClicked(TSharedPtr<FAssetData> ClickedData);
 
 	void OnCheckBoxStateChange(ECheckBoxState NewState, TSharedPtr<FAssetData> AssetData);
+	ECheckBoxState GetCheckBoxState(TSharedPtr<FAssetData> AssetData) const;
 	void OnGlobalCheckBoxStateChange(ECheckBoxState NewState);
+	FReply OnInvertSelectionButtonClicked();
+	FText GetDeleteSelectedButtonText() const;
+	FText GetReclaimableText() const;
 	FReply OnDeleteButtonClicked(TSharedPtr<FAssetData> AssetData);
 	FReply OnDeleteSelectedButtonClicked();
 
+	void SetDuplicateGroups(TArray<FAssetDuplicateGroup>&& InDuplicateGroups);
+	void RemoveDeletedAssets(const TArray<TSharedPtr<FAssetData>>& AttemptedAssetData);
+	void RemoveStoredAssets(const TBitArray<>& RemovedAssetBits);
+	void RemoveDeletedFromDuplicateGroups(const TBitArray<>& RemovedAssetBits);
+	void RebuildDisplayedAssets();
+
+	void OnSearchTextChanged(const FText& InSearchText);
+	void BuildTextFilterIndex();
+	void LaunchTextFilterQuery();
+	void ApplyTextFilterResult(const TSharedRef<const FAssetTextFilterResult>& Result);
+	void RefreshTextFilterMatches();
+	int32 GetFirstUnindexedSlot() const;
+	bool PassesTextFilter(const TSharedPtr<FAssetData>& AssetData) const;
+
+	void BuildSortKeys();
+	void SortViewAssets();
+
+	void StatAssetFiles();
+	FText GetAssetFileSizeText(TSharedPtr<FAssetData> AssetData) const;
+	FText GetAssetModifiedText(TSharedPtr<FAssetData> AssetData) const;
+
+	void RebuildStoredAssetIndices();
+	void ClearSelection();
+	void RecountSelection();
+	void SetAssetSelected(const TSharedPtr<FAssetData>& AssetData, bool bSelected);
+	void ForEachListedAsset(TFunctionRef<void(const TSharedPtr<FAssetData>&)> Callback) const;
+	TArray<TSharedPtr<FAssetData>> GetSelectedAssetData() const;
+	TBitArray<> GetListedAssetBits() const;
+
 
 
 private:
 	TArray<TSharedPtr<FAssetData>> StoredAssetsData;
 	TArray<TSharedPtr<FAssetData>> DisplayedAssetsData;
+
+	// What the picked view lists before the text filter, unless the view is grouped
+	TArray<TSharedPtr<FAssetData>> ViewAssetsData;
 	
-	TSharedPtr<SListView<TSharedPtr<FAssetData>>> ConstructedAssetListView;
-	TArray<TSharedPtr<FAssetData>> SelectedAssetData;
+	TSharedPtr<STreeView<TSharedPtr<FAssetData>>> ConstructedAssetListView;
+
+	// Set until every folder was listed
+	TSharedPtr<FAssetFolderStream> AssetStream;
 
-	TArray< TSharedRef <SCheckBox> > CheckBoxesArray;
+	// Folders the listed assets were gathered from, the scope of redirector fixup
+	TArray<FString> ListedRootPaths;
+
+	// Built once, rows only reference it
+	FSlateFontInfo RowTextFont;
+
+	// Selection is one bit per StoredAssetsData slot, so it covers rows without a widget and rows only reflect it
+	TMap<TSharedPtr<FAssetData>, int32> StoredAssetIndices;
+	TBitArray<> SelectedAssetBits;
+	int32 NumSelectedAssets = 0;
+	int64 SelectedFileSize = 0;
 	
 	TArray<TSharedPtr<FString>> ComboSourceItems;
 
 	TSharedPtr<STextBlock> ComboDisplayBox;
+	TSharedPtr<FString> SelectedListOption;
+
+	// Result of each list option, computed once per tab and kept until the tab deletes assets, more are streamed in
+	// or the asset registry reports a change. Async views are only cached if nothing changed while they ran.
+	struct FCachedListView
+	{
+		TArray<TSharedPtr<FAssetData>> ViewAssetsData;
+		TArray<FAssetDuplicateGroup> DuplicateGroups;
+	};
+	TMap<FString, FCachedListView> CachedListViews;
+	uint32 ListViewCacheGeneration = 0;
+
+	// A hashed view picked while assets are still streamed in or another scan runs starts once both are done
+	bool bHashedViewQueued = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+
+	// Grouped views list one root per group, its first asset, with the rest of the group as collapsible children
+	TArray<FAssetDuplicateGroup> DuplicateGroups;
+	TMap<TSharedPtr<FAssetData>, int32> DuplicateGroupByRoot;
+
+	// Index building and queries run on the thread pool, results of outdated queries are dropped by generation.
+	// Assets stored after the index was built are matched one by one until the next build covers them.
+	TSharedPtr<const FAssetTextFilterIndex> TextFilterIndex;
+	uint32 TextFilterIndexGeneration = 0;
+	uint32 AppliedTextFilterIndexGeneration = 0;
+	int32 NumTextIndexedAssets = 0;
+	TSharedPtr<const FAssetTextFilterResult> TextFilterResult;
+	FString TextFilterQuery;
+	uint32 TextFilterGeneration = 0;
+	TBitArray<> TextFilterMatchBits;
+
+	// One slot per StoredAssetsData entry, rebuilt on the thread pool whenever the stored assets change
+	TSharedPtr<const FAssetSortKeys> SortKeys;
+	uint32 SortKeysGeneration = 0;
+	FName SortColumn;
+	EColumnSortMode::Type SortMode = EColumnSortMode::None;
+
+	// Per StoredAssetsData slot as well, filled in batch by batch while the stat scan runs. INDEX_NONE until read.
+	TArray<int64> AssetFileSizes;
+	TArray<int64> AssetModifiedTicks;
+	TSharedPtr<FAssetScanProgress> FileStatProgress;
 };
\ No newline at end of file